@@ -52,6 +52,7 @@ bool MyAnaFunc(const string & fileName)
     for (unsigned int entry = 0; entry < t->GetEntries(); entry++){
         if (entry % 100 == 0) cout<<entry<<endl;
         t->GetEntry(entry);
+        DensifyModuleBranches();
         
         //fill the sector level info
         for (int i = 0; i < NSector; i++){
@@ -10,12 +10,15 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <cstdlib>
+#include "ZDCSparse.h"
 using namespace std;
 
 //need to adjust the following constants based on the simulation
 const bool UsePbWO4EMCal = false;
 const int NSector = 3;
-const int NModule[NSector] = {16, 16, 25};
+//modules per sector, read from Mod.NSecN when the file has it (DensifyModuleBranches)
+int NModule[NSector] = {16, 16, 25};
 const int NLayer[NSector]  = {15, 15, 42};
 const string SectorName[NSector] = {"PbSci1", "PbSci2", "WSci"};
 
@@ -29,6 +32,9 @@ enum DetectorIndex{
 //Declaration of leaf types
 //sector level variables
 Int_t           EventID;
+//true primary energy and PDG, only present in newer files
+Double_t        GenE = 0;
+Int_t           GenPDG = 0;
 Double_t        SecEdepEMC;
 Double_t        SecEdepSecSen[NSector];
 Double_t        SecEdepSecAbs[NSector];
@@ -40,9 +46,22 @@ vector<double>  *ModEdepSecAbs[NSector];
 vector<double>  *ModEdepSecSen[NSector];
 vector<int>     *ModNPEEmc      = 0;
 vector<int>     *ModNPESec[NSector];
-//sipm variables
+//zero-suppressed module level variables, only present with /evt/SparseModules
+bool            HasSparseModules = false;
+bool            HasModuleCounts = false;
+Int_t           ModNSec[NSector];
+vector<int>     *ModIdxSec[NSector];
+vector<double>  *ModSpEdepSecAbs[NSector];
+vector<double>  *ModSpEdepSecSen[NSector];
+vector<int>     *ModSpNPESec[NSector];
+//sipm variables, one entry per digitized SiPM above threshold
 vector<int>     *SipmID         = 0;
+vector<int>     *SipmNPE        = 0;
+vector<double>  *SipmAmp        = 0;
+vector<double>  *SipmCharge     = 0;
 vector<double>  *SipmTime       = 0;
+//leaked energy, index face*6 + class (front, back, side x gamma, e, mu, n, charged hadron, other)
+vector<double>  *LeakE          = 0;
 //particle level variables
 vector<int>     *ParDetID       = 0;
 vector<int>     *ParPDG         = 0;
@@ -115,10 +134,18 @@ void InitTree(TTree* t)
         ModEdepSecAbs[i] = 0;
         ModEdepSecSen[i] = 0;
         ModNPESec[i]     = 0;
+        ModIdxSec[i]       = 0;
+        ModSpEdepSecAbs[i] = 0;
+        ModSpEdepSecSen[i] = 0;
+        ModSpNPESec[i]     = 0;
     }
     
     //assign variables to branches
     t->SetBranchAddress("EventID", &EventID);
+    if (t->GetBranch("Gen.E")){
+        t->SetBranchAddress("Gen.E",   &GenE  );
+        t->SetBranchAddress("Gen.PDG", &GenPDG);
+    }
     //let EMC branches
     if (UsePbWO4EMCal){
         t->SetBranchAddress("Sec.EdepEMC",  &SecEdepEMC );
@@ -136,10 +163,32 @@ void InitTree(TTree* t)
         t->SetBranchAddress(Form("Mod.NPESec%d",     i+1), &ModNPESec[i]    );
     }
     
+    //zero-suppressed module branches
+    HasSparseModules = t->GetBranch("Mod.IdxSec1") != 0;
+    HasModuleCounts = t->GetBranch("Mod.NSec1") != 0;
+    if (HasModuleCounts){
+        for (int i = 0; i < NSector; i++) t->SetBranchAddress(Form("Mod.NSec%d", i+1), &ModNSec[i]);
+    }
+    if (HasSparseModules){
+        for (int i = 0; i < NSector; i++){
+            t->SetBranchAddress(Form("Mod.IdxSec%d",       i+1), &ModIdxSec[i]      );
+            t->SetBranchAddress(Form("Mod.SpEdepSecSen%d", i+1), &ModSpEdepSecSen[i]);
+            t->SetBranchAddress(Form("Mod.SpEdepSecAbs%d", i+1), &ModSpEdepSecAbs[i]);
+            t->SetBranchAddress(Form("Mod.SpNPESec%d",     i+1), &ModSpNPESec[i]    );
+        }
+    }
+    
     //Sipm level branches
     t->SetBranchAddress("Sipm.ID",   &SipmID  );
     t->SetBranchAddress("Sipm.Time", &SipmTime);
+    if (t->GetBranch("Sipm.Amp")){
+        t->SetBranchAddress("Sipm.NPE",    &SipmNPE   );
+        t->SetBranchAddress("Sipm.Amp",    &SipmAmp   );
+        t->SetBranchAddress("Sipm.Charge", &SipmCharge);
+    }
     
+    if (t->GetBranch("Leak.E")) t->SetBranchAddress("Leak.E", &LeakE);
+
     //particle level branches
     t->SetBranchAddress("Par.DetID",       &ParDetID       );
     t->SetBranchAddress("Par.PDG",         &ParPDG         );
@@ -160,6 +209,29 @@ void InitTree(TTree* t)
     t->SetBranchAddress("Par.Time",        &ParTime        );
 }
 
+void DensifyModuleBranches()
+{
+    //call after GetEntry: if the event was written with sparse module arrays,
+    //refill the dense Mod.* vectors so the analysis code does not change
+    if (!HasSparseModules) return;
+    for (int i = 0; i < NSector; i++){
+        if (ModIdxSec[i]->empty() && !ModEdepSecSen[i]->empty()) continue;
+        if (HasModuleCounts) NModule[i] = ModNSec[i];
+        //older files without Mod.NSecN: a module beyond the constants above means
+        //another /det/.../NModule, the dense arrays would have the wrong size
+        for (unsigned int j = 0; j < ModIdxSec[i]->size(); j++){
+            if (ModIdxSec[i]->at(j) >= NModule[i]){
+                cerr<<"Module index "<<ModIdxSec[i]->at(j)<<" of sector "<<i+1<<" beyond NModule = "<<NModule[i]
+                    <<", set NModule in AnaZDC.h to the simulated geometry"<<endl;
+                exit(1);
+            }
+        }
+        DensifyModules(*ModIdxSec[i], *ModSpEdepSecSen[i], NModule[i], *ModEdepSecSen[i]);
+        DensifyModules(*ModIdxSec[i], *ModSpEdepSecAbs[i], NModule[i], *ModEdepSecAbs[i]);
+        DensifyModules(*ModIdxSec[i], *ModSpNPESec[i],     NModule[i], *ModNPESec[i]    );
+    }
+}
+
 TH1D* Init1DHist(const string & name,  const int & nbin, const double & min, const double & max, 
                  const string & xaxis, const string & yaxis, const int & color)
 {
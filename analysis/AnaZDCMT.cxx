@@ -0,0 +1,335 @@
+//compiled, multi-threaded version of AnaZDC.cxx based on RDataFrame
+//
+//usage: AnaZDCMT [-t nThreads] [-o output.root] [-e beamEnergy(MeV)] input1.root ["shard_*.root" ...]
+//
+//only the branches needed by the booked histograms are read, and all
+//histograms are filled in a single event loop over all input shards
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TROOT.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TH2.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DetectorID.hh"
+
+using namespace std;
+using ROOT::RVecD;
+using ROOT::RVecI;
+using ZDC::DecodeDetectorID;
+
+//need to adjust the following constants based on the simulation
+const int NSector = 3;
+//layers per sector, replaced by Cell.NLayerSecN of the input when present
+int NLayer[NSector]  = {15, 15, 42};
+const string SectorName[NSector] = {"PbSci1", "PbSci2", "WSci"};
+
+//calibration constants used for the energy reconstruction of the shashlik sectors
+const double CaliConst[NSector] = {25, 25, 1};
+
+//number of layers in the longitudinal profile of the two shashlik sectors
+int NProfileLayer = NLayer[0] + NLayer[1];
+
+namespace {
+
+void PrintUsage()
+{
+    cerr << " Usage: " << endl;
+    cerr << " AnaZDCMT [-t nThreads] [-o output.root] [-e beamEnergy(MeV)] input.root [more inputs or globs]" << endl;
+    cerr << "   nThreads = 0 uses all available cores" << endl;
+}
+
+//per-particle detector information decoded from Par.DetID
+struct ParDetInfo
+{
+    RVecI sector;
+    RVecI type;
+    RVecI layer;
+};
+
+ParDetInfo DecodeAll(const RVecI & detID)
+{
+    ParDetInfo info;
+    const auto n = detID.size();
+    info.sector.resize(n);
+    info.type.resize(n);
+    info.layer.resize(n);
+    for (size_t i = 0; i < n; i++){
+        const ZDC::DetInfo id = DecodeDetectorID(detID[i]);
+        info.sector[i] = id.sector;
+        info.type[i]   = id.type;
+        info.layer[i]  = id.layer;
+    }
+    return info;
+}
+
+//1D histogram model with the same style as Init1DHist in AnaZDC.h
+void StyleHist(TH1* h, const int & color)
+{
+    h->SetLineWidth(2);
+    h->SetLineColor(color);
+    h->GetXaxis()->CenterTitle();
+    h->GetYaxis()->CenterTitle();
+    h->GetXaxis()->SetTitleSize(0.045);
+    h->GetYaxis()->SetTitleSize(0.045);
+    h->GetXaxis()->SetLabelSize(0.04);
+    h->GetYaxis()->SetLabelSize(0.04);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int nThreads = 0;
+    string outputName = "output_AnaZDC.root";
+    double inEnergy = 10000.;
+    vector<string> inputFiles;
+
+    for (int i = 1; i < argc; i++){
+        const string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) nThreads = atoi(argv[++i]);
+        else if (arg == "-o" && i + 1 < argc) outputName = argv[++i];
+        else if (arg == "-e" && i + 1 < argc) inEnergy = atof(argv[++i]);
+        else if (arg[0] == '-'){
+            PrintUsage();
+            return 1;
+        }
+        else inputFiles.push_back(arg);
+    }
+    if (inputFiles.empty()){
+        PrintUsage();
+        return 1;
+    }
+
+    ROOT::EnableImplicitMT(nThreads);
+    ROOT::RDataFrame df("ZDC", inputFiles);
+
+    //layer counts of the simulated geometry (/det/WSci/NLayer, /det/Shash/NLayer),
+    //checked again per event against the Cell.* arrays below
+    const bool hasLayerCounts = df.HasColumn("Cell.NLayerSec1");
+    if (hasLayerCounts){
+        TChain chain("ZDC");
+        for (const auto & file : inputFiles) chain.Add(file.c_str());
+        Int_t nLayer[NSector] = {0, 0, 0};
+        for (int i = 0; i < NSector; i++) chain.SetBranchAddress(Form("Cell.NLayerSec%d", i+1), &nLayer[i]);
+        if (chain.GetEntry(0) > 0 && nLayer[0] > 0){
+            for (int i = 0; i < NSector; i++) NLayer[i] = nLayer[i];
+        }
+        chain.ResetBranchAddresses();
+    }
+    NProfileLayer = NLayer[0] + NLayer[1];
+    auto nEntries = df.Count();
+
+    //the module level sums, adding the zero-suppressed arrays when present
+    //(only one of the dense and sparse vectors is filled in a given event)
+    ROOT::RDF::RNode node = df;
+    const bool hasSparse = df.HasColumn("Mod.IdxSec1");
+    for (int i = 0; i < NSector; i++){
+        if (hasSparse){
+            auto sum = [](const RVecD & dense, const RVecD & sparse){ return ROOT::VecOps::Sum(dense) + ROOT::VecOps::Sum(sparse); };
+            node = node.Define(Form("ModSumSen%d", i+1), sum, {Form("Mod.EdepSecSen%d", i+1), Form("Mod.SpEdepSecSen%d", i+1)});
+            node = node.Define(Form("ModSumAbs%d", i+1), sum, {Form("Mod.EdepSecAbs%d", i+1), Form("Mod.SpEdepSecAbs%d", i+1)});
+            continue;
+        }
+        node = node.Define(Form("ModSumSen%d", i+1), [](const RVecD & v){ return ROOT::VecOps::Sum(v); },
+                           {Form("Mod.EdepSecSen%d", i+1)});
+        node = node.Define(Form("ModSumAbs%d", i+1), [](const RVecD & v){ return ROOT::VecOps::Sum(v); },
+                           {Form("Mod.EdepSecAbs%d", i+1)});
+    }
+    node = node.Define("SecSen12", [](double s1, double s2){ return s1 + s2; },
+                       {"Sec.EdepSecSen1", "Sec.EdepSecSen2"});
+
+    //sector and module level histograms
+    vector<ROOT::RDF::RResultPtr<TH1D>> hist1D;
+    vector<ROOT::RDF::RResultPtr<TH2D>> hist2D;
+    vector<int> color1D;
+    for (int i = 0; i < NSector; i++){
+        const char* sec = SectorName[i].c_str();
+        hist1D.push_back(node.Histo1D<double>({Form("Sec_Edep_Sen_%s", sec), Form("Sec_Edep_Sen_%s;Edep [MeV];count", sec),
+                                              100, 0, 500}, Form("Sec.EdepSecSen%d", i+1)));
+        color1D.push_back(1);
+        hist1D.push_back(node.Histo1D<double>({Form("Sec_Edep_Abs_%s", sec), Form("Sec_Edep_Abs_%s;Edep [MeV];count", sec),
+                                              100, 0, 8000}, Form("Sec.EdepSecAbs%d", i+1)));
+        color1D.push_back(1);
+        hist1D.push_back(node.Histo1D<double>({Form("Mod_Edep_Sen_%s", sec), Form("Mod_Edep_Sen_%s;Edep [MeV];count", sec),
+                                              100, 0, 500}, Form("ModSumSen%d", i+1)));
+        color1D.push_back(2);
+        hist1D.push_back(node.Histo1D<double>({Form("Mod_Edep_Abs_%s", sec), Form("Mod_Edep_Abs_%s;Edep [MeV];count", sec),
+                                              100, 0, 8000}, Form("ModSumAbs%d", i+1)));
+        color1D.push_back(2);
+    }
+    hist2D.push_back(node.Histo2D<double, double>({"Edep_sec3_vs_sec12", "Edep_sec3_vs_sec12;Edep [MeV];Edep [MeV]",
+                                                  100, 0, 500, 100, 0, 500}, "SecSen12", "Sec.EdepSecSen3"));
+
+    //particle level histograms, only if the per-particle branches were written
+    ROOT::RDF::RResultPtr<TH1D> profileSen, profileAbs;
+    const bool hasPar = df.HasColumn("Par.DetID") && df.HasColumn("Par.Edep")
+                     && df.HasColumn("Par.InX")   && df.HasColumn("Par.InY");
+    if (hasPar){
+        auto par = node.Define("ParInfo", DecodeAll, {"Par.DetID"})
+                       .Define("ParSector", [](const ParDetInfo & p){ return p.sector; }, {"ParInfo"})
+                       .Define("ParType",   [](const ParDetInfo & p){ return p.type;   }, {"ParInfo"})
+                       .Define("ParLayer",  [](const ParDetInfo & p){ return p.layer;  }, {"ParInfo"});
+
+        for (int i = 0; i < NSector; i++){
+            const char* sec = SectorName[i].c_str();
+            par = par.Define(Form("ParSumSen%d", i+1),
+                             [i](const RVecI & s, const RVecI & t, const RVecD & e)
+                             { return ROOT::VecOps::Sum(e[s == i && t == ZDC::kSensitiveType]); },
+                             {"ParSector", "ParType", "Par.Edep"})
+                     .Define(Form("ParSumAbs%d", i+1),
+                             [i](const RVecI & s, const RVecI & t, const RVecD & e)
+                             { return ROOT::VecOps::Sum(e[s == i && t == ZDC::kAbsorberType]); },
+                             {"ParSector", "ParType", "Par.Edep"});
+            hist1D.push_back(par.Histo1D<double>({Form("Par_Edep_Sen_%s", sec), Form("Par_Edep_Sen_%s;Edep [MeV];count", sec),
+                                                 100, 0, 500}, Form("ParSumSen%d", i+1)));
+            color1D.push_back(4);
+            hist1D.push_back(par.Histo1D<double>({Form("Par_Edep_Abs_%s", sec), Form("Par_Edep_Abs_%s;Edep [MeV];count", sec),
+                                                 100, 0, 8000}, Form("ParSumAbs%d", i+1)));
+            color1D.push_back(4);
+        }
+
+        //the following histograms only use the two shashlik sectors
+        auto shash = par.Define("IsShash", [](const RVecI & s){ return s == 0 || s == 1; }, {"ParSector"})
+                        .Define("SenMask", [](const RVecI & m, const RVecI & t){ return m && t == ZDC::kSensitiveType; },
+                                {"IsShash", "ParType"})
+                        .Define("AbsMask", [](const RVecI & m, const RVecI & t){ return m && t == ZDC::kAbsorberType; },
+                                {"IsShash", "ParType"})
+                        .Define("ShashX",    [](const RVecD & x, const RVecI & m){ return RVecD(x[m]); }, {"Par.InX",  "IsShash"})
+                        .Define("ShashY",    [](const RVecD & y, const RVecI & m){ return RVecD(y[m]); }, {"Par.InY",  "IsShash"})
+                        .Define("ShashEdep", [](const RVecD & e, const RVecI & m){ return RVecD(e[m]); }, {"Par.Edep", "IsShash"})
+                        .Define("SenX",    [](const RVecD & x, const RVecI & m){ return RVecD(x[m]); }, {"Par.InX",  "SenMask"})
+                        .Define("SenEdep", [](const RVecD & e, const RVecI & m){ return RVecD(e[m]); }, {"Par.Edep", "SenMask"})
+                        .Define("AbsX",    [](const RVecD & x, const RVecI & m){ return RVecD(x[m]); }, {"Par.InX",  "AbsMask"})
+                        .Define("AbsEdep", [](const RVecD & e, const RVecI & m){ return RVecD(e[m]); }, {"Par.Edep", "AbsMask"})
+                        .Define("SenXLow",  [](const RVecD & x, const RVecD & e){ return RVecD(x[e < 10]); },             {"SenX", "SenEdep"})
+                        .Define("SenXMid",  [](const RVecD & x, const RVecD & e){ return RVecD(x[e >= 10 && e < 100]); }, {"SenX", "SenEdep"})
+                        .Define("SenXHigh", [](const RVecD & x, const RVecD & e){ return RVecD(x[e >= 100]); },           {"SenX", "SenEdep"})
+                        .Define("ProfileLayer",
+                                [](const RVecI & s, const RVecI & l){ return ROOT::VecOps::Where(s == 0, l + NLayer[1], l); },
+                                {"ParSector", "ParLayer"})
+                        .Define("SenLayer", [](const RVecI & l, const RVecI & m){ return RVecI(l[m]); }, {"ProfileLayer", "SenMask"})
+                        .Define("AbsLayer", [](const RVecI & l, const RVecI & m){ return RVecI(l[m]); }, {"ProfileLayer", "AbsMask"})
+                        .Define("ReconE",
+                                [inEnergy](const RVecI & s, const RVecD & e, const RVecI & m)
+                                {
+                                    const double recon = ROOT::VecOps::Sum(e[m && s == 0]) * CaliConst[0]
+                                                       + ROOT::VecOps::Sum(e[m && s == 1]) * CaliConst[1];
+                                    return recon / inEnergy;
+                                },
+                                {"ParSector", "Par.Edep", "SenMask"});
+
+        hist1D.push_back(shash.Histo1D<RVecD>({"EdepLow",  "energy (Edep < 10 MeV);X [mm];Count", 300, -300, 300}, "SenXLow"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD>({"EdepMid",  "energy (10 < Edep < 100 MeV);X [mm];Count", 300, -300, 300}, "SenXMid"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD>({"EdepHigh", "energy (Edep > 100 MeV);X [mm];Count", 300, -300, 300}, "SenXHigh"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD>({"hSen", "Sen_Layer_count; X [mm];Particle Count", 200, -400.0, 400.0}, "SenX"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD>({"hAbs", "Abs_Layer_count; X [mm];Particle Count", 200, -400.0, 400.0}, "AbsX"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD, RVecD>({"HSen", "Sen_Layer_Edep; X [mm];Edep", 200, -400.0, 400.0}, "SenX", "SenEdep"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<RVecD, RVecD>({"HAbs", "Abs_Layer_Edep; X [mm];Edep", 200, -400.0, 400.0}, "AbsX", "AbsEdep"));
+        color1D.push_back(1);
+        hist1D.push_back(shash.Histo1D<double>({"Recon_E_over_E", "Recon_E_over_E;E_{recon}/E;count", 100, 0, 2}, "ReconE"));
+        color1D.push_back(1);
+        hist2D.push_back(shash.Histo2D<RVecD, RVecD, RVecD>({"Edep_X_vs_Y", "Edep_X_vs_Y;X [mm];Y [mm]", 300, -300, 300, 300, -300, 300},
+                                                            "ShashX", "ShashY", "ShashEdep"));
+
+        //longitudinal profiles, normalized per event after the loop
+        profileSen = shash.Histo1D<RVecI, RVecD>({"EdepByLayer_Sen", "Sensitive Layers;Layer;Edep (MeV)", NProfileLayer, 0, double(NProfileLayer)},
+                                                 "SenLayer", "SenEdep");
+        profileAbs = shash.Histo1D<RVecI, RVecD>({"EdepByLayer_Abs", "Absorber Layers;Layer;Edep (MeV)", NProfileLayer, 0, double(NProfileLayer)},
+                                                 "AbsLayer", "AbsEdep");
+    }
+    else {
+        cout << "no Par.* branches in the input, particle level histograms are skipped" << endl;
+    }
+
+    //longitudinal profiles from the per-(module, layer) cell arrays, O(cells) per event
+    vector<ROOT::RDF::RResultPtr<TH1D>> profiles;
+    if (df.HasColumn("Cell.EdepSecSen1")){
+        auto cell = node;
+        for (int i = 0; i < NSector; i++){
+            const int nLayer = NLayer[i];
+            const int sector = i + 1;
+            auto checkLayers = [nLayer, sector](const RVecD & v, int eventNLayer){
+                if (eventNLayer != nLayer || v.size() % nLayer != 0){
+                    throw std::runtime_error(Form("Cell.EdepSec%d: %d cells with %d layers, the profile has %d layers",
+                                                  sector, int(v.size()), eventNLayer, nLayer));
+                }
+            };
+            auto sumLayers = [nLayer, checkLayers](const RVecD & v, int eventNLayer){
+                RVecD profile(nLayer, 0.);
+                if (v.empty()) return profile;
+                checkLayers(v, eventNLayer);
+                for (size_t j = 0; j < v.size(); j++) profile[j % nLayer] += v[j];
+                return profile;
+            };
+            //older files without Cell.NLayerSecN: the size check against the constants above
+            const string nLayerColumn = Form("CellNLayer%d", i+1);
+            if (hasLayerCounts) cell = cell.Define(nLayerColumn, [](int n){ return n; }, {Form("Cell.NLayerSec%d", i+1)});
+            else cell = cell.Define(nLayerColumn, [nLayer](){ return nLayer; }, {});
+            cell = cell.Define(Form("CellLayerBins%d", i+1), [nLayer](){
+                               RVecD bins(nLayer);
+                               for (int j = 0; j < nLayer; j++) bins[j] = j + 0.5;
+                               return bins; }, {})
+                       .Define(Form("CellProfileSen%d", i+1), sumLayers, {Form("Cell.EdepSecSen%d", i+1), nLayerColumn})
+                       .Define(Form("CellProfileAbs%d", i+1), sumLayers, {Form("Cell.EdepSecAbs%d", i+1), nLayerColumn});
+            const char* sec = SectorName[i].c_str();
+            profiles.push_back(cell.Histo1D<RVecD, RVecD>({Form("Cell_EdepByLayer_Sen_%s", sec), Form("Sensitive Layers %s;Layer;Edep (MeV)", sec),
+                                                              nLayer, 0, double(nLayer)}, Form("CellLayerBins%d", i+1), Form("CellProfileSen%d", i+1)));
+            profiles.push_back(cell.Histo1D<RVecD, RVecD>({Form("Cell_EdepByLayer_Abs_%s", sec), Form("Absorber Layers %s;Layer;Edep (MeV)", sec),
+                                                              nLayer, 0, double(nLayer)}, Form("CellLayerBins%d", i+1), Form("CellProfileAbs%d", i+1)));
+        }
+
+        //same layout as the particle level profile: PbSci2 layers first, then PbSci1
+        if (!hasPar){
+            auto join = [](const RVecD & sec2, const RVecD & sec1){ return ROOT::VecOps::Concatenate(sec2, sec1); };
+            auto shash = cell.Define("ShashLayerBins", [](){
+                                  RVecD bins(NProfileLayer);
+                                  for (int j = 0; j < NProfileLayer; j++) bins[j] = j + 0.5;
+                                  return bins; }, {})
+                             .Define("ShashProfileSen", join, {"CellProfileSen2", "CellProfileSen1"})
+                             .Define("ShashProfileAbs", join, {"CellProfileAbs2", "CellProfileAbs1"});
+            profileSen = shash.Histo1D<RVecD, RVecD>({"EdepByLayer_Sen", "Sensitive Layers;Layer;Edep (MeV)", NProfileLayer, 0, double(NProfileLayer)},
+                                                     "ShashLayerBins", "ShashProfileSen");
+            profileAbs = shash.Histo1D<RVecD, RVecD>({"EdepByLayer_Abs", "Absorber Layers;Layer;Edep (MeV)", NProfileLayer, 0, double(NProfileLayer)},
+                                                     "ShashLayerBins", "ShashProfileAbs");
+        }
+    }
+
+    //triggers the single event loop for all booked results
+    cout << "analyzing " << *nEntries << " entries with " << ROOT::GetThreadPoolSize() << " threads" << endl;
+
+    TFile* f = new TFile(outputName.c_str(), "RECREATE");
+    f->cd();
+    for (unsigned int i = 0; i < hist1D.size(); i++){
+        StyleHist(hist1D[i].GetPtr(), color1D[i]);
+        hist1D[i]->Write();
+    }
+    for (unsigned int i = 0; i < hist2D.size(); i++){
+        StyleHist(hist2D[i].GetPtr(), 1);
+        hist2D[i]->SetOption("colz");
+        hist2D[i]->Write();
+    }
+    //profiles are the mean edep per event
+    if (profileSen) profiles.push_back(profileSen);
+    if (profileAbs) profiles.push_back(profileAbs);
+    for (unsigned int i = 0; i < profiles.size(); i++){
+        if (*nEntries > 0) profiles[i]->Scale(1. / *nEntries);
+        profiles[i]->SetMarkerStyle(20);
+        profiles[i]->Write();
+    }
+    f->Close();
+
+    return 0;
+}
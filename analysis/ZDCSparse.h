@@ -0,0 +1,30 @@
+#ifndef ZDCSparse_h
+#define ZDCSparse_h
+
+//helpers to read the zero-suppressed module arrays written with
+///evt/SparseModules true: Mod.IdxSecN holds the module indices and
+//Mod.SpEdepSecSenN, Mod.SpEdepSecAbsN, Mod.SpNPESecN the values
+#include <vector>
+
+//expand (index, value) pairs into a dense vector of nModule entries,
+//the vector grows if an index is beyond nModule
+template <typename Idx, typename Val, typename Out>
+void DensifyModules(const Idx & idx, const Val & val, const int & nModule, Out & dense)
+{
+    dense.assign(nModule, 0);
+    for (unsigned int i = 0; i < idx.size() && i < val.size(); i++){
+        if (idx[i] >= (int)dense.size()) dense.resize(idx[i] + 1, 0);
+        dense[idx[i]] = val[i];
+    }
+}
+
+//same as above, returning a new std::vector
+template <typename T, typename Idx, typename Val>
+std::vector<T> DensifyModules(const Idx & idx, const Val & val, const int & nModule)
+{
+    std::vector<T> dense;
+    DensifyModules(idx, val, nModule, dense);
+    return dense;
+}
+
+#endif
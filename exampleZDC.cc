@@ -1,5 +1,11 @@
 #include "ActionInitialization.hh"
+#include "CheckpointManager.hh"
 #include "DetectorConstruction.hh"
+#include "Logger.hh"
+#include "LoggerMessenger.hh"
+#include "PhysicsTableCache.hh"
+#include "WorkerInitialization.hh"
+#include "ZDCHash.hh"
 #include "FTFP_BERT.hh"
 
 #include "G4RunManagerFactory.hh"
@@ -28,11 +34,36 @@
 
 namespace
 {
+// the two RanecuEngine seeds hashed from any seed number, instead of one of
+// the 215 rows of its seed table, so that any number of jobs get distinct
+// sequences; both within (0, 2147483399), the smaller engine modulus
+void SetRanecuSeeds(long seed)
+{
+    long seeds[3] = {0, 0, 0};
+    for (G4int i = 0; i < 2; i++) {
+        ZDC::Fnv1a h;
+        h.Add(static_cast<std::uint64_t>(seed));
+        h.Add(i);
+        seeds[i] = 1 + static_cast<long>(h.Value() % 2147483398ULL);
+    }
+    G4Random::setTheSeeds(seeds);
+}
+
 void PrintUsage()
 {
     G4cerr << " Usage: " << G4endl;
-    G4cerr << " exampleZDC [-m macro ] [-u UIsession] [-t nThreads] [-vDefault]" << G4endl;
-    G4cerr << "   note: -t option is available only for multi-threaded mode." << G4endl;
+    G4cerr << " exampleZDC [-m macro ] [-u UIsession] [-t nThreads] [--pin compact|scatter] [-p tableDir]"
+              " [--resume checkpoint] [--seed n] [-o outputBase] [--first-event n] [--log level] [-vDefault]"
+           << G4endl;
+    G4cerr << "   note: -t and --pin options are available only for multi-threaded mode." << G4endl;
+    G4cerr << "   --pin: pin the workers to CPUs, filling a NUMA node first (compact) or spread over the nodes (scatter)"
+           << G4endl;
+    G4cerr << "   -p: physics table cache directory (default PhysicsTables), none to disable" << G4endl;
+    G4cerr << "   --resume: continue the /ckpt/BeamOn of the macro from this checkpoint file" << G4endl;
+    G4cerr << "   --seed: seed number >= 0, hashed into the engine seeds, instead of the clock" << G4endl;
+    G4cerr << "   -o: output file <outputBase>.root (default ZDC), --first-event: first EventID (default 0)" << G4endl;
+    G4cerr << "   --log: debug, info (default) or production (warnings only, no best-unit stepping verbose)"
+           << G4endl;
 }
 }  // namespace
 
@@ -42,36 +73,62 @@ int main(int argc, char** argv)
 {
     // Evaluate arguments
     //
-    if (argc > 7) {
-        PrintUsage();
-        return 1;
-    }
-
-    // set random seed
-    G4Random::setTheEngine(new CLHEP::RanecuEngine);
-    
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
-    long randseed =  ts.tv_sec * 1000000000L + ts.tv_nsec;
-    std::cout << "Using randomseed " << randseed << std::endl;
-    G4Random::setTheSeed(randseed);
-
-    
     G4String macro;
     G4String session;
+    G4String physicsTableDir = "PhysicsTables";
+    G4String resumeFile;
+    G4String outputBase = "ZDC";
+    long randseed = -1;
+    long firstEvent = 0;
+    G4String logLevel = "info";
     G4bool verboseBestUnits = true;
 #ifdef G4MULTITHREADED
     G4int nThreads = 0;
+    G4String pinMode = "none";
 #endif
     for (G4int i = 1; i < argc; i = i + 2) {
+        // every option but -vDefault takes a value
+        if (i + 1 == argc && G4String(argv[i]) != "-vDefault") {
+            PrintUsage();
+            return 1;
+        }
         if (G4String(argv[i]) == "-m")
             macro = argv[i + 1];
         else if (G4String(argv[i]) == "-u")
             session = argv[i + 1];
+        else if (G4String(argv[i]) == "-p")
+            physicsTableDir = G4String(argv[i + 1]) == "none" ? G4String() : G4String(argv[i + 1]);
+        else if (G4String(argv[i]) == "--resume")
+            resumeFile = argv[i + 1];
+        else if (G4String(argv[i]) == "--seed") {
+            randseed = G4UIcommand::ConvertToLongInt(argv[i + 1]);
+            if (randseed < 0) {
+                PrintUsage();
+                return 1;
+            }
+        }
+        else if (G4String(argv[i]) == "-o")
+            outputBase = argv[i + 1];
+        else if (G4String(argv[i]) == "--first-event")
+            firstEvent = G4UIcommand::ConvertToLongInt(argv[i + 1]);
+        else if (G4String(argv[i]) == "--log") {
+            logLevel = argv[i + 1];
+            if (!ZDC::Logger::SetLevel(logLevel)) {
+                PrintUsage();
+                return 1;
+            }
+        }
 #ifdef G4MULTITHREADED
         else if (G4String(argv[i]) == "-t") {
             nThreads = G4UIcommand::ConvertToInt(argv[i + 1]);
         }
+        else if (G4String(argv[i]) == "--pin") {
+            pinMode = argv[i + 1];
+            if (pinMode != "compact" && pinMode != "scatter" && pinMode != "none") {
+                PrintUsage();
+                return 1;
+            }
+        }
 #endif
         else if (G4String(argv[i]) == "-vDefault") {
             verboseBestUnits = false;
@@ -83,6 +140,16 @@ int main(int argc, char** argv)
         }
     }
 
+    // set random seed from the clock or --seed (zdc_submit: one per shard)
+    G4Random::setTheEngine(new CLHEP::RanecuEngine);
+    if (randseed < 0) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        randseed = ts.tv_sec * 1000000000L + ts.tv_nsec;
+    }
+    std::cout << "Using randomseed " << randseed << std::endl;
+    SetRanecuSeeds(randseed);
+
     // Detect interactive mode (if no macro provided) and define UI session
     G4UIExecutive* ui = nullptr;
     if (!macro.size()) {
@@ -92,8 +159,8 @@ int main(int argc, char** argv)
     // Optionally: choose a different Random engine...
     // G4Random::setTheEngine(new CLHEP::MTwistEngine);
 
-    // Use G4SteppingVerboseWithUnits
-    if (verboseBestUnits) {
+    // Use G4SteppingVerboseWithUnits, not in production runs
+    if (verboseBestUnits && logLevel != "production") {
         G4int precision = 4;
         G4SteppingVerbose::UseBestUnit(precision);
     }
@@ -105,6 +172,9 @@ int main(int argc, char** argv)
     if (nThreads > 0) {
         runManager->SetNumberOfThreads(nThreads);
     }
+    if (pinMode != "none" && runManager->GetRunManagerType() != G4RunManager::sequentialRM) {
+        runManager->SetUserInitialization(new ZDC::WorkerInitialization(pinMode));
+    }
 #endif
 
     // Set mandatory initialization classes
@@ -118,7 +188,13 @@ int main(int argc, char** argv)
 
     G4OpticalPhysics* opticalPhysics = new G4OpticalPhysics();
     physicsList->RegisterPhysics(opticalPhysics);
+    // step limits of the detector regions (/det/Region/SetMaxStep)
+    physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+    // the fast simulation of the optical photons is registered by
+    // /det/UseFastFiberModel true, without it the photons skip its process
     runManager->SetUserInitialization(physicsList);
+    // physics tables stored to / retrieved from disk, deleted by the state manager
+    new ZDC::PhysicsTableCache(physicsList, physicsTableDir);
     auto opticalParams = G4OpticalParameters::Instance(); 
     //  opticalParams->SetProcessActivation("Cerenkov", false);
     //  opticalParams->SetProcessActivation("Scintillation", false);
@@ -127,6 +203,17 @@ int main(int argc, char** argv)
     auto actionInitialization = new ZDC::ActionInitialization();
     runManager->SetUserInitialization(actionInitialization);
 
+    // checkpointed runs (/ckpt/), the engine state is restored at /ckpt/BeamOn
+    auto checkpointManager = new ZDC::CheckpointManager();
+    checkpointManager->SetOutputBase(outputBase);
+    checkpointManager->SetFirstEvent(firstEvent);
+    if (!resumeFile.empty() && !checkpointManager->Resume(resumeFile)) {
+        return 1;
+    }
+
+    // log level, rate limit and ring buffer (/log/)
+    auto loggerMessenger = new ZDC::LoggerMessenger();
+
     // Initialize visualization
     auto visManager = new G4VisExecutive;
     // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
@@ -159,6 +246,8 @@ int main(int argc, char** argv)
     // in the main() program !
 
     delete visManager;
+    delete checkpointManager;
+    delete loggerMessenger;
     delete runManager;
 }
 
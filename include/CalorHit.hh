@@ -1,7 +1,8 @@
 #ifndef CalorHit_h
 #define CalorHit_h 1
 
-#include "G4Allocator.hh"
+#include "HitArena.hh"
+
 #include "G4THitsCollection.hh"
 #include "G4Threading.hh"
 #include "G4ThreeVector.hh"
@@ -57,8 +58,7 @@ public:
     G4double GetTime() const;
     const G4VPhysicalVolume *GetPhysV() const;
     G4int GetCopyNo() const;
-    G4String GetPhysVolName() const;
-    G4String GetParticleName() const;
+    const G4String& GetPhysVolName() const;
 
     void SetPID(G4int &val);
     void SetTrackID(G4int &val);
@@ -75,9 +75,6 @@ public:
     void SetPhysV(G4VPhysicalVolume *val);
     void SetCopyNo(G4int &val);
 
-    void SetPhysVolName(G4String &val);
-    void SetParticleName(G4String &val);
-
     void AddEdep(G4double &val);
     void AddTrackLength(G4double &val);
     
@@ -97,34 +94,29 @@ private:
     G4double      fTime;
     const G4VPhysicalVolume *fPhysV;
     G4int         fCopyNo;
-    G4String      fPhysicalVolName;
-    G4String      fParticleName;
+    // no G4String members: the hits stay trivially destructible for the arena,
+    // the volume name comes from fPhysV and the particle from fPID
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 using CalorHitsCollection = G4THitsCollection<CalorHit>;
 
-extern G4ThreadLocal G4Allocator<CalorHit>* CalorHitAllocator;
+extern G4ThreadLocal HitArena<CalorHit>* CalorHitArena;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 inline void* CalorHit::operator new(size_t)
 {
-    if (!CalorHitAllocator) {
-        CalorHitAllocator = new G4Allocator<CalorHit>;
+    if (!CalorHitArena) {
+        CalorHitArena = new HitArena<CalorHit>;
     }
-    void* hit;
-    hit = (void*)CalorHitAllocator->MallocSingle();
-    return hit;
+    return CalorHitArena->Allocate();
 }
 
 inline void CalorHit::operator delete(void* hit)
 {
-    if (!CalorHitAllocator) {
-        CalorHitAllocator = new G4Allocator<CalorHit>;
-    }
-    CalorHitAllocator->FreeSingle((CalorHit*)hit);
+    CalorHitArena->Free(hit);
 }
 
 inline void CalorHit::Add(G4double de, G4double dl)
@@ -204,14 +196,9 @@ inline G4int CalorHit::GetCopyNo() const
     return fCopyNo;
 }
 
-inline G4String CalorHit::GetPhysVolName() const
-{
-    return fPhysicalVolName;
-}
-
-inline G4String CalorHit::GetParticleName() const
+inline const G4String& CalorHit::GetPhysVolName() const
 {
-    return fParticleName;
+    return fPhysV->GetName();
 }
 
 
@@ -285,16 +272,6 @@ inline void CalorHit::SetCopyNo(G4int &val)
     fCopyNo = val;
 }
 
-inline void CalorHit::SetPhysVolName(G4String &val)
-{
-    fPhysicalVolName = val;
-}
-
-inline void CalorHit::SetParticleName(G4String &val)
-{
-    fParticleName = val;
-}
-
 inline void CalorHit::AddEdep(G4double &val)
 {
     fEdep += val;
@@ -8,6 +8,8 @@
 #include "G4VSensitiveDetector.hh"
 #include "globals.hh"
 
+#include <vector>
+
 class G4Step;
 class G4HCofThisEvent;
 class G4TouchableHistory;
@@ -22,6 +24,11 @@ namespace ZDC
 ///
 /// The values are accounted in hits in ProcessHits() function which is called
 /// by Geant4 kernel at each step.
+///
+/// In cell mode (/det/SD/CellMode, default) no hits are made: the edep and
+/// the first time go straight into dense per-sector arrays, index
+/// module * NLayer + layer, sized from the geometry in Initialize(); sector
+/// 0 Shash1, 1 Shash2, 2 WSci, 3 EMC. Per-track hits are for debugging.
 
 class CalorimeterSD : public G4VSensitiveDetector
 {
@@ -34,8 +41,23 @@ public:
     G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
     void EndOfEvent(G4HCofThisEvent* hitCollection) override;
 
+    G4bool IsCellMode() const { return fCellMode; }
+    G4int GetCellNLayer(G4int sector) const { return fCellNLayer[sector]; }
+    const std::vector<G4double>& GetCellEdepSen(G4int sector) const { return fCellEdepSen[sector]; }
+    const std::vector<G4double>& GetCellEdepAbs(G4int sector) const { return fCellEdepAbs[sector]; }
+    // first time of a sensitive deposit, -1 without
+    const std::vector<G4double>& GetCellTime(G4int sector) const { return fCellTime[sector]; }
+
 private:
+    static constexpr G4int kNCellSector = NSector + 1;
+
     CalorHitsCollection* fHitsCollection = nullptr;
+    std::size_t fLastNofHits = 0;
+    G4bool fCellMode = false;
+    G4int fCellNLayer[kNCellSector] = {0, 0, 0, 0};
+    std::vector<G4double> fCellEdepSen[kNCellSector];
+    std::vector<G4double> fCellEdepAbs[kNCellSector];
+    std::vector<G4double> fCellTime[kNCellSector];
     G4int fNofCells = 0;
 };
 
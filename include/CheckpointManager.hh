@@ -0,0 +1,94 @@
+#ifndef ZDCCheckpointManager_h
+#define ZDCCheckpointManager_h 1
+
+#include "globals.hh"
+
+#include <string>
+
+namespace ZDC
+{
+
+class CheckpointMessenger;
+
+/// Checkpointed long runs (/ckpt/).
+///
+/// /ckpt/BeamOn N runs the N events as a series of G4 runs (parts) of
+/// /ckpt/EveryEvents events, or as many as fit in /ckpt/EveryMinutes at the
+/// rate of the previous part. Each part writes and closes its own output
+/// file, ZDC_<part>.root, so the rows of the finished parts are on disk;
+/// then the checkpoint file (/ckpt/File) is rewritten with the total and
+/// finished events, the next part and the state of the master random engine.
+///
+/// exampleZDC --resume <file> with the same macro restores the engine state
+/// before the next part and continues the series. The event seeds of a
+/// part only depend on that state, so the resumed parts are the ones the
+/// uninterrupted run would have produced (the same events with
+/// /ckpt/EveryEvents alone, the same statistics with /ckpt/EveryMinutes).
+/// The EventID column and the beam energy list / event file position count
+/// the events of the earlier parts.
+///
+/// Without /ckpt/EveryEvents and /ckpt/EveryMinutes, /ckpt/BeamOn is a plain
+/// /run/beamOn writing ZDC.root.
+///
+/// The shards of zdc_submit set the output base name (exampleZDC -o, ZDC by
+/// default, also naming the default checkpoint <base>.ckpt) and the number
+/// of their first event (--first-event), added to the event IDs above.
+
+class CheckpointManager
+{
+  public:
+    CheckpointManager();
+    ~CheckpointManager();
+
+    // nullptr in the applications without checkpoints
+    static CheckpointManager* Instance() { return fInstance; }
+
+    void BeamOn(G4int nEvents);
+    G4bool Resume(const G4String& fileName);
+    void SetOutputBase(const G4String& base);
+    void SetFirstEvent(G4long firstEvent) { fFirstEvent = firstEvent; }
+
+    const G4String& GetOutputFileName() const { return fOutputFileName; }
+    // events of the earlier parts, for the event IDs of the current one
+    G4long GetEventOffset() const { return fFirstEvent + fEventOffset; }
+    // events done before this process, at the first part
+    G4long GetResumedEvents() const { return fFirstEvent + fResumedEvents; }
+
+    void SetNewValueInt(const G4String& key, G4int value);
+    void SetNewValueDouble(const G4String& key, G4double value);
+    void SetNewValueString(const G4String& key, const G4String& value);
+
+  private:
+    G4int NextPartSize(G4double secondsPerEvent) const;
+    G4String GetFileName() const { return fFileName.empty() ? fOutputBase + ".ckpt" : fFileName; }
+    void Save() const;
+
+    static constexpr G4int kProbeEvents = 100;  // first part with /ckpt/EveryMinutes alone
+
+    static CheckpointManager* fInstance;
+    CheckpointMessenger* fMessenger = nullptr;
+
+    G4String fFileName;  // <base>.ckpt if empty
+    G4int fEveryEvents = 0;
+    G4double fEveryMinutes = 0.;
+
+    G4long fTotal = 0;
+    G4long fDone = 0;
+    G4int fPart = 0;
+    // of the part being run
+    G4long fEventOffset = 0;
+    G4String fOutputBase = "ZDC";
+    G4String fOutputFileName = "ZDC.root";
+    G4long fFirstEvent = 0;
+
+    // state read by Resume(), applied at the next BeamOn()
+    G4bool fResumed = false;
+    G4long fResumedEvents = 0;
+    std::string fEngineState;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CheckpointMessenger_h
+#define CheckpointMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithALongInt;
+class G4UIcommand;
+
+namespace ZDC
+{
+
+class CheckpointManager;
+
+class CheckpointMessenger : public G4UImessenger
+{
+  public:
+    CheckpointMessenger(CheckpointManager*);
+    ~CheckpointMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+    CheckpointManager* fCheckpointManager = nullptr;
+
+    G4UIdirectory* fCkptDirectory = nullptr;
+
+    G4UIcmdWithAString* fFile = nullptr;
+    G4UIcmdWithALongInt* fEveryEvents = nullptr;
+    G4UIcmdWithADouble* fEveryMinutes = nullptr;
+    G4UIcmdWithALongInt* fBeamOn = nullptr;
+};
+
+}  // namespace ZDC
+#endif
@@ -60,6 +60,10 @@ constexpr G4double kMirrorThick = 0.015  *cm; //cm
 constexpr G4double kMirrorDiameter = kHoleDiameter; 
 constexpr G4double kSipmThick = 0.015  *cm; 
 
+// Leakage shell around the sectors
+constexpr G4double kLeakageGap = 1. *cm;   // clearance to the sector boxes
+constexpr G4double kLeakageThick = 1. *mm;
+
 constexpr G4int kNofRods = 4;
 //constexpr G4double kRodLength = kModuleLength + 1.*cm;
 constexpr G4double kRodHoleDiameter = 0.18 *cm; //cm
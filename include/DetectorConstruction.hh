@@ -9,6 +9,10 @@
 #include "G4Threading.hh"
 #include "globals.hh"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 class G4VPhysicalVolume;
 class G4GlobalMagFieldMessenger;
 
@@ -19,6 +23,7 @@ namespace ZDC
 {
 
 class DetectorMessenger;
+class SDFilter;
 
 /// Detector construction class to define materials and geometry.
 /// The calorimeter is a box made of a given number of layers. A layer consists
@@ -40,21 +45,55 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 {
 public:
     DetectorConstruction();
-    ~DetectorConstruction() override = default;
+    ~DetectorConstruction() override;
 
     G4VPhysicalVolume* Construct() override;
     void ConstructSDandField() override;
 
     void SetNewValueDouble(G4String, G4double);
     void SetNewValueInt(G4String, G4int);
+    void SetOpticalDataDir(const G4String&);
+    // GDML copy of each built geometry in <directory>/geometry_<key>.gdml,
+    // loaded instead of rebuilding when the key matches; empty or "none" off
+    void SetGeometryCache(const G4String& directory);
+    void ExportGDML(const G4String& fileName) const;
 
     void UpdateGeometry();
 
+    // number of modules per side and of layers, sector 0 Shash1, 1 Shash2, 2 WSci, 3 EMC
+    G4int GetNModule(G4int sector) const { return sector == 3 ? vNEMc : sector == 2 ? vNWSci : vNShash; }
+    G4int GetNLayer(G4int sector) const { return sector == 3 ? 1 : sector == 2 ? vNWSciLayer : vNShashLayer; }
+
+    // CalorimeterSD accumulates per (module, layer) cell instead of per (track, cell) hit
+    G4bool GetCalorCellMode() const { return fCalorCellMode; }
+
+    // production cuts and max step of the <sector>_Absorber/_Active/_Optics/_Fiber
+    // regions, the key is a region name, a sector (Emc, WSci, Shash1, Shash2),
+    // a part (Absorber, Active, Optics, Fiber) or "all"; later settings win
+    void SetRegionCut(const G4String& key, G4double cut);
+    void SetRegionMaxStep(const G4String& key, G4double step);
+    // track kill thresholds (RegionInformation, SteppingAction), cut is
+    // TimeCut, EnergyCut, NeutronTimeCut or NeutronEnergyCut; "all" also
+    // covers the world region (air around the modules)
+    void SetRegionKillCut(const G4String& cut, const G4String& key, G4double value);
+    void PrintRegions() const;
+
+    // step filters of the readout sensitive detectors (AbsorberSD1, SipmSD2),
+    // the key is an SD name or "all"
+    std::vector<SDFilter*> GetSDFilters(const G4String& key) const;
+    void PrintSDFilters() const;
+
 private:
     // methods
     //
     void DefineMaterials();
     G4VPhysicalVolume* DefineVolumes();
+    void SetupRegions();
+    void ApplyRegionSettings();
+    void RegisterFastSimulation();
+    G4String GetGeometryCacheFile() const;
+    G4VPhysicalVolume* ReadGDML(const G4String& fileName);
+    void WriteGDML(const G4VPhysicalVolume* world, const G4String& fileName) const;
 
     ZDCMaterials* fMaterials;
     G4LogicalVolume* fCoatingLogical_EM;
@@ -110,8 +149,17 @@ private:
     static G4ThreadLocal G4GlobalMagFieldMessenger* fMagFieldMessenger;
     // magnetic field messenger
 
-    G4bool fCheckOverlaps = true;  // option to activate checking of volumes overlaps
+    G4bool fCheckOverlaps = false;  // option to activate checking of volumes overlaps
+    G4int fVerbose = 0;  // material printout, /det/Verbose
+    G4bool fUseFastFiberModel = false;  // WLSFiberModel in the fiber cores, /det/UseFastFiberModel
+    G4bool fFastSimulationRegistered = false;  // G4FastSimulationPhysics for the optical photons
+    G4bool fUseLeakageShells = true;  // leakage scoring and kill shell, /det/UseLeakageShells
+    G4bool fCalorCellMode = true;  // cell arrays in CalorimeterSD, /det/SD/CellMode
     G4int fNofLayers = -1;  // number of layers
+    G4String fGeometryCacheDir;  // /det/GeometryCache, empty if off
+    // part of the GDML cache key, bump it with every change of the volumes
+    // placed in Construct() or of the Constants.hh dimensions
+    static constexpr G4int kGeometryVersion = 1;
 
     DetectorMessenger* fMessenger;
 
@@ -150,7 +198,18 @@ private:
     G4int vNFiberHole_WSci = kNFiberHole;
     G4int vNFiberHole_Shash1 = kNFiberHole;
     G4int vNFiberHole_Shash2 = kNFiberHole;
-    
+
+    // SD step filters by SD name, shared by the threads
+    std::map<G4String, SDFilter*> fSDFilters;
+
+    // Regions
+    std::vector<G4String> fRegionNames;
+    std::vector<std::pair<G4String, G4double>> fRegionCuts;
+    std::vector<std::pair<G4String, G4double>> fRegionMaxSteps;
+    std::vector<std::pair<G4String, G4double>> fRegionTimeCuts;
+    std::vector<std::pair<G4String, G4double>> fRegionEnergyCuts;
+    std::vector<std::pair<G4String, G4double>> fRegionNeutronTimeCuts;
+    std::vector<std::pair<G4String, G4double>> fRegionNeutronEnergyCuts;
     
 
 
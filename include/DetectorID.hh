@@ -0,0 +1,61 @@
+#ifndef ZDCDetectorID_h
+#define ZDCDetectorID_h 1
+
+// Detector ID helpers shared by the simulation and the compiled analysis.
+// Plain C++ only, so that ROOT-side code can include it without Geant4.
+//
+// The detector ID is the sum of the copy numbers along the touchable
+// history (see README_DetectorID), which for calorimeter layers gives
+//
+//  _   _   _   _   _   _   _
+// sec mod mod typ lay lay otr
+//
+// sec: 1 Shash1, 2 Shash2, 3 WSci, 4 EMC
+// mod: module number, starting from 1
+// typ: 1 sensitive, 2 absorber, 3 reflector
+// lay: layer number, starting from 0
+// otr: other parts (coating, plates, holes, fibers, SiPM...)
+
+namespace ZDC
+{
+
+constexpr int kSectorIDUnit = 1000000;
+constexpr int kModuleIDUnit = 10000;
+constexpr int kTypeIDUnit   = 1000;
+constexpr int kLayerIDUnit  = 10;
+
+enum DetectorType {
+    kOtherType     = 0,
+    kSensitiveType = 1,
+    kAbsorberType  = 2,
+    kReflectorType = 3
+};
+
+/// Decoded detector ID, sector and module indices start from 0
+
+struct DetInfo
+{
+    int sector;
+    int module;
+    int type;
+    int layer;
+    int other;
+};
+
+inline constexpr DetInfo DecodeDetectorID(int id)
+{
+    return DetInfo{ id / kSectorIDUnit - 1,
+                    (id % kSectorIDUnit) / kModuleIDUnit - 1,
+                    (id % kModuleIDUnit) / kTypeIDUnit,
+                    (id % kTypeIDUnit) / kLayerIDUnit,
+                    id % kLayerIDUnit };
+}
+
+static_assert(DecodeDetectorID(3021000 + 410).sector == 2, "bad sector decoding");
+static_assert(DecodeDetectorID(3021000 + 410).module == 1, "bad module decoding");
+static_assert(DecodeDetectorID(3021000 + 410).type   == kSensitiveType, "bad type decoding");
+static_assert(DecodeDetectorID(3021000 + 410).layer  == 41, "bad layer decoding");
+
+}  // namespace ZDC
+
+#endif
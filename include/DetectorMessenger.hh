@@ -10,6 +10,7 @@ class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithADouble;
 class G4UIcmdWithALongInt;
 class G4UIcmdWithoutParameter; 
+class G4UIcmdWithABool;
 class G4UIcommand;
 
 namespace ZDC
@@ -31,6 +32,14 @@ class DetectorMessenger : public G4UImessenger
     G4UIdirectory* fDetDirectory = nullptr;
 
     G4UIcmdWithoutParameter *fInitGeo = nullptr;
+    G4UIcmdWithABool* fCheckOverlaps = nullptr;
+    G4UIcmdWithABool* fUseFastFiberModel = nullptr;
+    G4UIcmdWithABool* fUseLeakageShells = nullptr;
+    G4UIcmdWithALongInt* fVerbose = nullptr;
+    G4UIcmdWithAString* fOpticalDataDir = nullptr;
+    G4UIcmdWithADoubleAndUnit* fOpticalBinWidth = nullptr;
+    G4UIcmdWithAString* fGeometryCache = nullptr;
+    G4UIcmdWithAString* fExportGDML = nullptr;
 
     //Emc
     G4UIcmdWithALongInt* vNEmc = nullptr;
@@ -54,6 +63,21 @@ class DetectorMessenger : public G4UImessenger
     G4UIcmdWithALongInt* vNFiberHole_WSci = nullptr;
     G4UIcmdWithALongInt* vNFiberHole_Shash1 = nullptr;
     G4UIcmdWithALongInt* vNFiberHole_Shash2 = nullptr;
+
+    // SD filters
+    G4UIdirectory* fSDDirectory = nullptr;
+    G4UIcommand* fSDTimeWindow = nullptr;
+    G4UIcommand* fSDEnergyFloor = nullptr;
+    G4UIcommand* fSDParticles = nullptr;
+    G4UIcmdWithoutParameter* fSDList = nullptr;
+    G4UIcmdWithABool* fSDCellMode = nullptr;
+
+    // Regions
+    G4UIdirectory* fRegionDirectory = nullptr;
+    G4UIcommand* fRegionCut = nullptr;
+    G4UIcommand* fRegionMaxStep = nullptr;
+    G4UIcommand* fRegionKillCut[4] = {nullptr, nullptr, nullptr, nullptr};
+    G4UIcmdWithoutParameter* fRegionList = nullptr;
 };
 
 }  // namespace ZDC
@@ -2,9 +2,12 @@
 #define ZDCEventAction_h 1
 
 #include "G4UserEventAction.hh"
+#include "G4Accumulable.hh"
 
 #include "CalorHit.hh"
 #include "SiPMHit.hh"
+#include "SipmDigitizer.hh"
+#include "PileupOverlay.hh"
 #include "Constants.hh"
 #include "globals.hh"
 #include "EventMessenger.hh"
@@ -14,6 +17,9 @@ class G4Event;
 namespace ZDC
 {
 
+class LeakageSD;
+class CalorimeterSD;
+
 /// Event action class
 ///
 /// In EndOfEventAction(), it prints the accumulated quantities of the energy
@@ -36,6 +42,8 @@ class EventAction : public G4UserEventAction
     void AddEdep_pi0(G4double Edep) { fEPi0 += Edep; }
     void AddEscapeKine(G4double Edep) {  fEscapeKine += Edep; }
     void AddEscape_KineAndNonBaryonMass(G4double Edep) { fEscapeKineAndNonBaryonMass += Edep; }
+    // Stepping action function, kinetic energy of the tracks killed by the region cuts
+    void AddEnergyCut(G4double Ekin) { fECut += Ekin; }
 
     // Particle information
     std::vector<G4int>&    GetDetectorID()              { return detectorID; }
@@ -60,16 +68,51 @@ class EventAction : public G4UserEventAction
     std::vector<G4double>& GetModEdepSen(const int & i) { return ModEdepSen[i]; }
     std::vector<G4double>& GetModEdepAbs(const int & i) { return ModEdepAbs[i]; }
 
+    // Digitized SiPMs above threshold, and the raw photon hits (/digi/Sipm/RawHits)
     std::vector<G4int>& GetSipmID()                     { return SipmID; }
+    std::vector<G4int>& GetSipmNPE()                    { return SipmNPE; }
+    std::vector<G4double>& GetSipmAmp()                 { return SipmAmp; }
+    std::vector<G4double>& GetSipmCharge()              { return SipmCharge; }
     std::vector<G4double>& GetSipmTime()                { return SipmTime; }
+    std::vector<G4int>& GetSipmHitID()                  { return SipmHitID; }
+    std::vector<G4double>& GetSipmHitTime()             { return SipmHitTime; }
+    SipmDigitizer& GetSipmDigitizer()                   { return fSipmDigitizer; }
+    PileupOverlay& GetPileupOverlay()                   { return fPileup; }
+
+    // Leaked energy per (face, particle class) of the leakage shell, see LeakageSD
+    std::vector<G4double>& GetLeakE()                   { return LeakE; }
 
     std::vector<G4int>& GetNPEEmcModule()               { return NPEEmcModule; }
     std::vector<G4int>& GetModNPE(const int & i)        { return ModNPE[i]; }
 
+    // Zero-suppressed module arrays, (module index, value) pairs
+    std::vector<G4int>& GetSpEmcIdx()                   { return SpEmcIdx; }
+    std::vector<G4double>& GetSpEEmcModule()            { return SpEEmcModule; }
+    std::vector<G4int>& GetSpNPEEmcModule()             { return SpNPEEmcModule; }
+    std::vector<G4int>& GetSpModIdx(const int & i)      { return SpModIdx[i]; }
+    std::vector<G4double>& GetSpModEdepSen(const int & i) { return SpModEdepSen[i]; }
+    std::vector<G4double>& GetSpModEdepAbs(const int & i) { return SpModEdepAbs[i]; }
+    std::vector<G4int>& GetSpModNPE(const int & i)      { return SpModNPE[i]; }
+
+    // Per-(module, layer) edep of each sector, index module*NLayer + layer
+    std::vector<G4double>& GetCellEdepSen(const int & i) { return CellEdepSen[i]; }
+    std::vector<G4double>& GetCellEdepAbs(const int & i) { return CellEdepAbs[i]; }
+    // first time of a sensitive deposit per cell, -1 without
+    std::vector<G4double>& GetCellTime(const int & i)    { return CellTime[i]; }
+
+    // Run sums of the sensitive edep per sector and (index NSector) of all sectors
+    G4Accumulable<G4double>& GetRunEdepSen(const int & i)  { return fRunEdepSen[i]; }
+    G4Accumulable<G4double>& GetRunEdepSen2(const int & i) { return fRunEdepSen2[i]; }
+
     void SetNewValueInt(G4String key, G4int value);
+    void SetNewValueDouble(G4String key, G4double value);
     
     private:
     // methods
+    void FillSparseModules();
+    void FillFromCells(const CalorimeterSD* sd);
+    void RecordPileup();
+    void OverlayPileup();
     CalorHitsCollection* GetHitsCollection(G4int hcID, const G4Event* event) const;
     SipmHitsCollection* GetHitsCollection2(G4int hcID, const G4Event* event) const;
     void PrintEventStatistics(G4double absoEdep, G4double absoTrackLength, G4double gapEdep,
@@ -98,7 +141,29 @@ class EventAction : public G4UserEventAction
     std::vector<G4double> ModEdepAbs[3];
 
     std::vector<G4int> SipmID;
+    std::vector<G4int> SipmNPE;
+    std::vector<G4double> SipmAmp;
+    std::vector<G4double> SipmCharge;
     std::vector<G4double> SipmTime;
+    std::vector<G4int> SipmHitID;
+    std::vector<G4double> SipmHitTime;
+
+    SipmDigitizer fSipmDigitizer;
+    std::vector<std::pair<G4int, G4double>> fSipmPhotons;
+    std::vector<SipmDigi> fSipmDigis;
+
+    PileupOverlay fPileup;
+    std::vector<PileupOverlay::Background> fPileupEvents;
+    G4int fPileupN = 0;
+
+    std::vector<G4double> LeakE;
+    LeakageSD* fLeakageSD = nullptr;
+    G4bool fLeakageSDChecked = false;
+    CalorimeterSD* fCalorSD = nullptr;
+
+    // true primary kinematics: total kinetic energy and PDG of the first primary
+    G4double fGenEnergy = 0.;
+    G4int fGenPDG = 0;
 
     G4int fNPEEmcTot;
     G4int fSecNEP[NSector];
@@ -106,6 +171,19 @@ class EventAction : public G4UserEventAction
     std::vector<G4int> NPEEmcModule;
     std::vector<G4int> ModNPE[3];
 
+    std::vector<G4int> SpEmcIdx;
+    std::vector<G4double> SpEEmcModule;
+    std::vector<G4int> SpNPEEmcModule;
+    std::vector<G4int> SpModIdx[3];
+    std::vector<G4double> SpModEdepSen[3];
+    std::vector<G4double> SpModEdepAbs[3];
+    std::vector<G4int> SpModNPE[3];
+
+    std::vector<G4double> CellEdepSen[3];
+    std::vector<G4double> CellEdepAbs[3];
+    std::vector<G4double> CellTime[3];
+    G4int fCellNLayer[NSector] = {0, 0, 0};
+
     G4int fEventID;
     time_t start, end;
 
@@ -113,6 +191,9 @@ class EventAction : public G4UserEventAction
     G4double fSecEdepTotSen[NSector];
     G4double fSecEdepTotAbs[NSector];
 
+    G4Accumulable<G4double> fRunEdepSen[NSector + 1] = {0., 0., 0., 0.};
+    G4Accumulable<G4double> fRunEdepSen2[NSector + 1] = {0., 0., 0., 0.};
+
     // data members
     G4int fAbsHCID = -1;
     G4int fGapHCID = -1;
@@ -124,9 +205,15 @@ class EventAction : public G4UserEventAction
     G4int fNWSci = kNWSci ;
     G4int fNShash = kNShash;
 
+    G4bool fSparseModules = false;
+    G4double fZeroSuppression = 0.;
+    G4bool fCellEdep = false;
+    G4bool fSipmRawHits = false;
+
     G4double fEPi0;
     G4double fEscapeKine;
     G4double fEscapeKineAndNonBaryonMass;
+    G4double fECut = 0.;
 
 
 };
@@ -0,0 +1,106 @@
+#ifndef ZDCEventFileReader_h
+#define ZDCEventFileReader_h 1
+
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ZDC
+{
+
+/// Final-state particles of a generator event, grouped by production vertex
+struct GenParticle
+{
+    G4int pdg;
+    G4ThreeVector momentum;
+};
+
+struct GenVertex
+{
+    G4ThreeVector position;
+    G4double time = 0.;
+    std::vector<GenParticle> particles;
+};
+
+struct GenEvent
+{
+    std::vector<GenVertex> vertices;
+};
+
+/// Reader of generator events, HepMC3 ASCII (Asciiv3, status 1 particles)
+/// or the binary format written by WriteBinary() (zdc_convert_events).
+///
+/// Open() shares one reader per file in the process. A read-ahead thread
+/// parses the file into a bounded buffer and the worker threads Take() the
+/// event with their event ID: file event = events of the earlier runs +
+/// event ID, so the partitioning over the threads does not change which
+/// event a G4 event gets. A resumed run (exampleZDC --resume) opens the file
+/// at the first event it has not done, the read-ahead thread drops the
+/// earlier ones. Read() is the plain sequential interface.
+///
+/// Binary format: "ZDCGEN01", then per event the number of vertices and,
+/// per vertex, x y z (mm) t (ns) as double, the number of particles and
+/// (int32 PDG, px py pz in MeV as double) per particle.
+
+class EventFileReader
+{
+  public:
+    static std::shared_ptr<EventFileReader> Open(const G4String& fileName, long firstEvent = 0);
+
+    EventFileReader(const G4String& fileName, G4bool readAhead, long firstEvent = 0);
+    ~EventFileReader();
+
+    // false at the end of the file
+    G4bool Take(G4int runID, G4int eventID, GenEvent& event);
+    G4bool Read(GenEvent& event);
+
+    static void WriteBinaryHeader(std::ostream& out);
+    static void WriteBinary(std::ostream& out, const GenEvent& event);
+
+  private:
+    void ReadAhead();
+    G4bool ReadHepMC(GenEvent& event);
+    G4bool ReadBinary(GenEvent& event);
+
+    static constexpr std::size_t kBufferSize = 256;
+
+    G4String fFileName;
+    std::ifstream fIn;
+    G4bool fBinary = false;
+    G4double fMomentumUnit = CLHEP::GeV;
+    G4double fLengthUnit = CLHEP::mm;
+    std::string fPendingLine;  // "E" line of the next HepMC event
+
+    // read-ahead buffer by file event index
+    std::thread fThread;
+    std::mutex fMutex;
+    std::condition_variable fFilled;
+    std::condition_variable fTaken;
+    std::map<long, GenEvent> fBuffer;
+    long fNextIndex = 0;  // next event parsed
+    long fFirstEvent = 0;  // events dropped before the buffer
+    long fMaxWanted = -1;  // largest index a thread waits for, read past a full buffer
+    G4bool fEnd = false;
+    G4bool fStop = false;
+
+    // file event index of the current run
+    G4int fRunID = -1;
+    long fRunOffset = 0;
+    long fRunEvents = 0;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
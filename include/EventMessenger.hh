@@ -9,6 +9,7 @@ class G4UIcmdWithAString;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithADouble;
 class G4UIcmdWithALongInt;
+class G4UIcmdWithABool;
 class G4UIcmdWithoutParameter; 
 class G4UIcommand;
 
@@ -29,6 +30,7 @@ class EventMessenger : public G4UImessenger
     EventAction* fEventAction = nullptr;
 
     G4UIdirectory* fDetDirectory = nullptr;
+    G4UIdirectory* fEvtDirectory = nullptr;
 
     G4UIcmdWithoutParameter *fInitGeo = nullptr;
 
@@ -36,6 +38,38 @@ class EventMessenger : public G4UImessenger
     G4UIcmdWithALongInt* fNWSci = nullptr;
     G4UIcmdWithALongInt* fNShash = nullptr;
 
+    // output control
+    G4UIcmdWithABool* fSparseModules = nullptr;
+    G4UIcmdWithABool* fCellEdep = nullptr;
+    G4UIcmdWithADoubleAndUnit* fZeroSuppression = nullptr;
+
+    // SiPM digitization
+    G4UIdirectory* fDigiDirectory = nullptr;
+    G4UIdirectory* fSipmDirectory = nullptr;
+    G4UIcmdWithADouble* fSipmPDE = nullptr;
+    G4UIcmdWithADouble* fSipmCrosstalk = nullptr;
+    G4UIcmdWithADouble* fSipmAfterpulse = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmAfterpulseTime = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmRecoveryTime = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmDarkRate = nullptr;
+    G4UIcmdWithADouble* fSipmGainSpread = nullptr;
+    G4UIcmdWithADouble* fSipmThreshold = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmGateStart = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmSampleWidth = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmRiseTime = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSipmFallTime = nullptr;
+    G4UIcmdWithABool* fSipmRawHits = nullptr;
+
+    // pile-up overlay
+    G4UIdirectory* fPileupDirectory = nullptr;
+    G4UIcmdWithAString* fPileupLibrary = nullptr;
+    G4UIcmdWithAString* fPileupWriteLibrary = nullptr;
+    G4UIcmdWithADouble* fPileupMu = nullptr;
+    G4UIcmdWithADoubleAndUnit* fPileupBunchSpacing = nullptr;
+    G4UIcmdWithALongInt* fPileupBunchesBefore = nullptr;
+    G4UIcmdWithALongInt* fPileupBunchesAfter = nullptr;
+    G4UIcmdWithADoubleAndUnit* fPileupEdepWindow = nullptr;
+
     G4UIcmdWithAString* fTargMatCmd = nullptr;
     G4UIcmdWithAString* fChamMatCmd = nullptr;
 
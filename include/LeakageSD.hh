@@ -0,0 +1,64 @@
+#ifndef ZDCLeakageSD_h
+#define ZDCLeakageSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+#include <array>
+
+class G4Step;
+class G4HCofThisEvent;
+class G4TouchableHistory;
+class G4ParticleDefinition;
+
+namespace ZDC
+{
+
+// faces of the leakage shell, the copy numbers of its plates
+enum LeakageFace { kLeakFront, kLeakBack, kLeakSide, kNLeakFace };
+// particle classes of the leaked energy
+enum LeakageClass { kLeakGamma, kLeakElectron, kLeakMuon, kLeakNeutron, kLeakChargedHadron, kLeakOther, kNLeakClass };
+
+/// Sensitive detector of the thin air plates enclosing the sectors.
+///
+/// A track entering a plate from inside the envelope leaves the detector:
+/// its kinetic energy is added to the (face, class) bin and it is killed
+/// there instead of being transported through the world. Optical photons
+/// are killed without scoring. The bins, index face * kNLeakClass + class,
+/// are reset in Initialize() and read by EventAction.
+
+class LeakageSD : public G4VSensitiveDetector
+{
+  public:
+    explicit LeakageSD(const G4String& name);
+    ~LeakageSD() override = default;
+
+    void Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+
+    const std::array<G4double, kNLeakFace * kNLeakClass>& GetEnergy() const { return fEnergy; }
+    // summed kinetic energy, and the mass of the non-baryons
+    G4double GetKineticEnergy() const { return fKineticEnergy; }
+    G4double GetNonBaryonMass() const { return fNonBaryonMass; }
+
+  private:
+    LeakageClass Classify(const G4ParticleDefinition* particle) const;
+
+    std::array<G4double, kNLeakFace * kNLeakClass> fEnergy{};
+    G4double fKineticEnergy = 0.;
+    G4double fNonBaryonMass = 0.;
+
+    const G4ParticleDefinition* fOpticalPhoton;
+    const G4ParticleDefinition* fGamma;
+    const G4ParticleDefinition* fElectron;
+    const G4ParticleDefinition* fPositron;
+    const G4ParticleDefinition* fMuonMinus;
+    const G4ParticleDefinition* fMuonPlus;
+    const G4ParticleDefinition* fNeutron;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
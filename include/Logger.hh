@@ -0,0 +1,51 @@
+#ifndef ZDCLogger_h
+#define ZDCLogger_h 1
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace ZDC
+{
+
+/// Leveled, rate-limited log of the application (/log/, exampleZDC --log).
+///
+/// A message is printed if its level is at least the print level:
+///  debug:      everything, e.g. each placed volume
+///  info:       (default) also the progress every /run/printProgress events
+///  production: only the warnings
+/// At most /log/RateLimit messages per tag (Event, Geometry, ...) and second
+/// are printed, the others are counted and reported with the next printed one.
+///
+/// The messages of level info and up, and the debug ones at print level
+/// debug, are also kept in a ring of the last kRingSize messages of all
+/// threads, printed by /log/Dump, e.g. after a quiet production run. Build
+/// an expensive message only if IsEnabled() for its level.
+
+class Logger
+{
+  public:
+    enum Level { kDebug = 0, kInfo = 1, kWarning = 2 };
+
+    // debug, info or production, false for other names
+    static G4bool SetLevel(const G4String& name);
+    static void SetRateLimit(G4int perSecond) { fRateLimit = perSecond; }
+
+    static G4bool IsEnabled(Level level) { return level >= std::min<G4int>(fLevel, kInfo); }
+    static void Log(Level level, const G4String& tag, const G4String& message);
+    static void Dump();
+
+  private:
+    static constexpr std::size_t kRingSize = 1000;
+
+    static std::atomic<G4int> fLevel;      // print level
+    static std::atomic<G4int> fRateLimit;  // per tag and second, 0 for no limit
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
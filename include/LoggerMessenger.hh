@@ -0,0 +1,33 @@
+#ifndef LoggerMessenger_h
+#define LoggerMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
+
+namespace ZDC
+{
+
+class LoggerMessenger : public G4UImessenger
+{
+  public:
+    LoggerMessenger();
+    ~LoggerMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+    G4UIdirectory* fLogDirectory = nullptr;
+
+    G4UIcmdWithAString* fLevel = nullptr;
+    G4UIcmdWithAnInteger* fRateLimit = nullptr;
+    G4UIcmdWithoutParameter* fDump = nullptr;
+};
+
+}  // namespace ZDC
+#endif
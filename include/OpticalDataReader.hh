@@ -0,0 +1,58 @@
+#ifndef ZDCOpticalDataReader_h
+#define ZDCOpticalDataReader_h 1
+
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalSurface.hh"
+#include "globals.hh"
+
+namespace ZDC
+{
+
+/// Optical properties of materials and surfaces read from a data directory,
+/// one <name>.dat file per material or surface (see data/optics/v1).
+///
+/// File format, # starts a comment:
+///   <PROPERTY> <energy unit> <value unit>    property vector, followed by
+///   <energy> <value>                         rows in increasing energy
+///   end
+///   const <PROPERTY> <value> <unit>          constant property
+///   surface <model> <finish> <type> <value>  G4OpticalSurface settings
+/// Units are Geant4 unit symbols, "1" for dimensionless values and "1/X"
+/// for inverse units (e.g. 1/MeV).
+///
+/// Property vectors are UniformPropertyVector, resampled onto a uniform
+/// energy grid with the given bin width over the energy range of the file.
+
+class OpticalDataReader
+{
+  public:
+    OpticalDataReader(const G4String& directory, G4double binWidth);
+    ~OpticalDataReader() = default;
+
+    G4MaterialPropertiesTable* ReadMaterial(const G4String& name) const;
+    G4OpticalSurface* ReadSurface(const G4String& name, const G4String& surfaceName) const;
+
+    const G4String& GetDirectory() const { return fDirectory; }
+
+  private:
+    struct SurfaceSettings
+    {
+        G4bool defined = false;
+        G4OpticalSurfaceModel model = glisur;
+        G4OpticalSurfaceFinish finish = polished;
+        G4SurfaceType type = dielectric_dielectric;
+        G4double value = 1.;
+    };
+
+    G4MaterialPropertiesTable* Read(const G4String& name, SurfaceSettings& surface) const;
+    void Fail(const G4String& name, G4int line, const G4String& message) const;
+
+    G4String fDirectory;
+    G4double fBinWidth;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
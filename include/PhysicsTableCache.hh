@@ -0,0 +1,53 @@
+#ifndef ZDCPhysicsTableCache_h
+#define ZDCPhysicsTableCache_h 1
+
+#include "G4VStateDependent.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+
+class G4VUserPhysicsList;
+
+namespace ZDC
+{
+
+/// On-disk cache of the physics tables.
+///
+/// The first time the physics tables are built (Idle -> Init at /run/initialize
+/// in MT mode, at the first /run/beamOn otherwise) a key is computed from the
+/// Geant4 version, the physics constructors, the EM parameters, the production
+/// cuts of every region and the materials they contain. If <directory>/<key>
+/// holds a complete table set it is retrieved, otherwise the tables are built
+/// and stored there once ready (Init -> Idle). The table time and the time
+/// since start-up are printed in both cases.
+///
+/// An empty directory only reports the timing.
+
+class PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    PhysicsTableCache(G4VUserPhysicsList* physicsList, const G4String& directory);
+    ~PhysicsTableCache() override = default;
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+  private:
+    G4String ComputeKey() const;
+    void StoreTables();
+
+    G4VUserPhysicsList* fPhysicsList;
+    G4String fDirectory;
+    G4String fTableDirectory;
+
+    G4bool fBuilding = false;
+    G4bool fDone = false;
+    G4bool fRetrieved = false;
+
+    G4Timer fStartupTimer;
+    G4Timer fTableTimer;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
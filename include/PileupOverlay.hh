@@ -0,0 +1,106 @@
+#ifndef ZDCPileupOverlay_h
+#define ZDCPileupOverlay_h 1
+
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ZDC
+{
+
+/// Response of one event as stored in a pile-up library: the modules with
+/// energy deposit and the photons detected by each SiPM.
+struct PileupEvent
+{
+    struct Deposit
+    {
+        G4int sector;  // 0..NSector-1, NSector for the EMC (sensitive only)
+        G4int module;
+        G4float edepSen;
+        G4float edepAbs;
+    };
+
+    std::vector<Deposit> deposits;
+    std::vector<std::pair<G4int, G4float>> photons;  // SiPM ID, arrival time
+};
+
+/// Library of pre-generated (minimum-bias) event responses.
+///
+/// Binary file, "ZDCPILE1" then one record per event: the number of
+/// deposits and (int8 sector, int32 module, float sen, float abs) per
+/// deposit, the number of SiPMs and (int32 ID, uint32 n, n float times) per
+/// SiPM. Only non-empty modules and SiPMs are stored, in single precision.
+/// Loaded once per process and shared read-only by the threads.
+
+class PileupLibrary
+{
+  public:
+    static std::shared_ptr<const PileupLibrary> Load(const G4String& fileName);
+
+    std::size_t GetNumberOfEvents() const { return fEvents.size(); }
+    const PileupEvent& GetEvent(std::size_t i) const { return fEvents[i]; }
+
+    static void WriteHeader(std::ostream& out);
+    static void WriteEvent(std::ostream& out, const PileupEvent& event);
+
+  private:
+    std::vector<PileupEvent> fEvents;
+};
+
+/// Pile-up overlay at the response level.
+///
+/// For every bunch crossing from -BunchesBefore to +BunchesAfter around the
+/// signal (crossing 0) a Poisson number of background events with mean Mu
+/// is drawn from the library, with the time offset crossing * BunchSpacing.
+/// Their SiPM photons are shifted by the offset and digitized together with
+/// the signal photons; their module deposits, which carry no time, are only
+/// added for crossings within EdepWindow of the signal (default in-time only).
+///
+/// With WriteLibrary the response of every event (before any overlay) is
+/// appended to a library file instead, shared by the worker threads.
+
+class PileupOverlay
+{
+  public:
+    struct Background
+    {
+        const PileupEvent* event;
+        G4double offset;
+        G4bool inEdepWindow;
+    };
+
+    PileupOverlay() = default;
+    ~PileupOverlay() = default;
+
+    G4bool IsActive() const { return fMu > 0. && !fLibraryFile.empty(); }
+    G4bool IsRecording() const { return !fOutputFile.empty(); }
+
+    // background events of this signal event
+    void Draw(std::vector<Background>& backgrounds);
+    void Record(const PileupEvent& event);
+
+    void SetNewValueInt(const G4String& key, G4int value);
+    void SetNewValueDouble(const G4String& key, G4double value);
+    void SetNewValueString(const G4String& key, const G4String& value);
+
+  private:
+    G4String fLibraryFile;
+    std::shared_ptr<const PileupLibrary> fLibrary;
+    G4String fOutputFile;
+
+    G4double fMu = 0.;
+    G4double fBunchSpacing = 25. * CLHEP::ns;
+    G4int fBunchesBefore = 5;
+    G4int fBunchesAfter = 5;
+    G4double fEdepWindow = 0.;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
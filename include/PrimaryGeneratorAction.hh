@@ -2,6 +2,12 @@
 #define ZDCPrimaryGeneratorAction_h 1
 
 #include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
 
 class G4ParticleGun;
 class G4GeneralParticleSource;
@@ -12,12 +18,21 @@ class G4ParticleDefinition;
 namespace ZDC
 {
 
-/// The primary generator action class with particle gum.
+class EventFileReader;
+class PrimaryGeneratorMessenger;
+
+/// The primary generator action class.
 ///
-/// It defines a single particle which hits the calorimeter
-/// perpendicular to the input face. The type of the particle
-/// can be changed via the G4 build-in commands of G4ParticleGun class
-/// (see the macros provided with this example).
+/// Three modes, /gen/Mode:
+///  gps:  G4GeneralParticleSource, configured with the /gps/ commands (default)
+///  beam: one particle per event from /gen/Origin, pencil or gaussian in
+///        position, direction and energy (/gen/Beam/), without the GPS parsing;
+///        the energy is fixed, taken from a list in turn by event ID (equal
+///        statistics, energies interleaved over the threads) or drawn from a
+///        flat or log-flat spectrum
+///  file: the final-state particles of generator events (/gen/File/), HepMC3
+///        ASCII or binary, shifted to /gen/Origin; G4 event i gets file event i
+///        counted over the runs, whatever the thread
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -27,10 +42,40 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
     void GeneratePrimaries(G4Event* event) override;
 
+    void SetNewValueDouble(G4String key, G4double value);
+    void SetNewValueString(G4String key, G4String value);
+    void SetNewValueVector(G4String key, G4ThreeVector value);
+
   private:
+    void GenerateBeam(G4Event* event);
+    void GenerateFromFile(G4Event* event);
+    G4ParticleDefinition* FindParticle(G4int pdg);
+    G4double BeamEnergy(G4long eventID) const;
+
 //    G4ParticleGun* fParticleGun = nullptr;  // G4 particle gun
     G4GeneralParticleSource* fParticleGun;
+    G4ParticleGun* fBeamGun = nullptr;
+    PrimaryGeneratorMessenger* fMessenger = nullptr;
+
+    G4String fMode = "gps";
+    G4ThreeVector fOrigin;
+
+    // beam mode
+    G4ThreeVector fBeamDirection = G4ThreeVector(0., 0., 1.);
+    G4double fBeamEnergy = 10. * GeV;
+    std::vector<G4double> fBeamEnergyList;  // /gen/Beam/EnergyList
+    G4String fBeamSpectrum;                 // flat or log, /gen/Beam/EnergySpectrum
+    G4double fBeamEnergyMin = 0.;
+    G4double fBeamEnergyMax = 0.;
+    G4double fBeamEnergySpread = 0.;  // relative sigma
+    G4double fBeamSigma = 0.;         // transverse sigma, 0 for a pencil beam
+    G4double fBeamDivergence = 0.;    // angular sigma per plane
 
+    // file mode
+    G4String fFileName;
+    std::shared_ptr<EventFileReader> fReader;
+    G4double fMaxTheta = 0.;  // acceptance around the beam direction, 0 for all
+    G4bool fEndOfFile = false;
 };
 
 }  // namespace ZDC
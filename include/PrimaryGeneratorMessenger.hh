@@ -0,0 +1,52 @@
+#ifndef PrimaryGeneratorMessenger_h
+#define PrimaryGeneratorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithADouble;
+class G4UIcmdWith3Vector;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcommand;
+
+namespace ZDC
+{
+
+class PrimaryGeneratorAction;
+
+class PrimaryGeneratorMessenger : public G4UImessenger
+{
+  public:
+    PrimaryGeneratorMessenger(PrimaryGeneratorAction*);
+    ~PrimaryGeneratorMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+    PrimaryGeneratorAction* fPrimaryGenerator = nullptr;
+
+    G4UIdirectory* fGenDirectory = nullptr;
+    G4UIdirectory* fBeamDirectory = nullptr;
+    G4UIdirectory* fFileDirectory = nullptr;
+
+    G4UIcmdWithAString* fMode = nullptr;
+    G4UIcmdWith3VectorAndUnit* fOrigin = nullptr;
+
+    G4UIcmdWithAString* fBeamParticle = nullptr;
+    G4UIcmdWithADoubleAndUnit* fBeamEnergy = nullptr;
+    G4UIcmdWithADouble* fBeamEnergySpread = nullptr;
+    G4UIcmdWithAString* fBeamEnergyList = nullptr;
+    G4UIcommand* fBeamEnergySpectrum = nullptr;
+    G4UIcmdWith3Vector* fBeamDirection = nullptr;
+    G4UIcmdWithADoubleAndUnit* fBeamSigma = nullptr;
+    G4UIcmdWithADoubleAndUnit* fBeamDivergence = nullptr;
+
+    G4UIcmdWithAString* fFileName = nullptr;
+    G4UIcmdWithADoubleAndUnit* fMaxTheta = nullptr;
+};
+
+}  // namespace ZDC
+#endif
@@ -0,0 +1,43 @@
+#ifndef ZDCRegionInformation_h
+#define ZDCRegionInformation_h 1
+
+#include "G4VUserRegionInformation.hh"
+#include "globals.hh"
+
+namespace ZDC
+{
+
+/// Track kill thresholds of a detector region, set by /det/Region/Set*Cut
+/// and applied in SteppingAction. A negative value disables the cut; the
+/// neutron values, when set, replace the all-particle ones for neutrons.
+/// The energy cut does not apply to optical photons.
+
+class RegionInformation : public G4VUserRegionInformation
+{
+  public:
+    RegionInformation() = default;
+    ~RegionInformation() override = default;
+
+    void Print() const override;
+
+    void SetTimeCut(G4double value) { fTimeCut = value; }
+    void SetEnergyCut(G4double value) { fEnergyCut = value; }
+    void SetNeutronTimeCut(G4double value) { fNeutronTimeCut = value; }
+    void SetNeutronEnergyCut(G4double value) { fNeutronEnergyCut = value; }
+
+    G4double GetTimeCut(G4bool neutron) const { return neutron && fNeutronTimeCut >= 0. ? fNeutronTimeCut : fTimeCut; }
+    G4double GetEnergyCut(G4bool neutron) const { return neutron && fNeutronEnergyCut >= 0. ? fNeutronEnergyCut : fEnergyCut; }
+    G4bool HasCuts() const { return fTimeCut >= 0. || fEnergyCut >= 0. || fNeutronTimeCut >= 0. || fNeutronEnergyCut >= 0.; }
+
+  private:
+    G4double fTimeCut = -1.;          // global time
+    G4double fEnergyCut = -1.;        // kinetic energy
+    G4double fNeutronTimeCut = -1.;
+    G4double fNeutronEnergyCut = -1.;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -5,6 +5,8 @@
 
 #include "EventAction.hh"
 
+#include "G4Timer.hh"
+
 class EventAction;
 
 class G4Run;
@@ -28,6 +30,9 @@ namespace ZDC
 ///
 /// In EndOfRunAction(), the accumulated statistic and computed
 /// dispersion is printed.
+/// The master also prints the run time and the relative spread (sigma/mean)
+/// of the sensitive edep of each sector, used by cutscan.mac to compare
+/// region cuts.
 ///
 
 class RunAction : public G4UserRunAction
@@ -40,7 +45,10 @@ class RunAction : public G4UserRunAction
     void EndOfRunAction(const G4Run*) override;
 
   private:
+    void PrintRunSummary(const G4Run*) const;
+
     EventAction* fEventAction;
+    G4Timer fTimer;
 };
 
 }  // namespace ZDC
@@ -0,0 +1,51 @@
+#ifndef ZDCSDFilter_h
+#define ZDCSDFilter_h 1
+
+#include "G4VSDFilter.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleDefinition;
+
+namespace ZDC
+{
+
+/// Step filter of a sensitive detector (/det/SD/), checked by Geant4 before
+/// ProcessHits(), so rejected steps never create or look up a hit:
+///  - readout time window on the global time of the step start,
+///  - floor on the energy deposit of the step (also drops the charged steps
+///    without deposit, only counted in the track length), never applied to
+///    the optical photons, so it only cuts AbsorberSD1 steps,
+///  - accepted particles, as G4SDParticleFilter, empty for all.
+/// One filter per SD is shared by the threads, it is only changed between
+/// runs. Everything open by default.
+
+class SDFilter : public G4VSDFilter
+{
+  public:
+    explicit SDFilter(const G4String& name);
+    ~SDFilter() override = default;
+
+    G4bool Accept(const G4Step* step) const override;
+    // for hits made without a step (WLSFiberModel)
+    G4bool AcceptTime(G4double time) const { return time >= fTimeMin && time <= fTimeMax; }
+
+    void SetTimeWindow(G4double tmin, G4double tmax);
+    void SetEnergyFloor(G4double value) { fEnergyFloor = value; }
+    // false if the particle is unknown, "all" clears the list
+    G4bool AddParticle(const G4String& particleName);
+    void Print() const;
+
+  private:
+    G4double fTimeMin;
+    G4double fTimeMax;
+    G4double fEnergyFloor = 0.;
+    std::vector<const G4ParticleDefinition*> fParticles;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -1,7 +1,8 @@
 #ifndef SipmHit_h
 #define SipmHit_h 1
 
-#include "G4Allocator.hh"
+#include "HitArena.hh"
+
 #include "G4THitsCollection.hh"
 #include "G4Threading.hh"
 #include "G4ThreeVector.hh"
@@ -52,26 +53,21 @@ class SipmHit : public G4VHit
 
 using SipmHitsCollection = G4THitsCollection<SipmHit>;
 
-extern G4ThreadLocal G4Allocator<SipmHit>* SipmHitAllocator;
+extern G4ThreadLocal HitArena<SipmHit>* SipmHitArena;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 inline void* SipmHit::operator new(size_t)
 {
-    if (!SipmHitAllocator) {
-        SipmHitAllocator = new G4Allocator<SipmHit>;
+    if (!SipmHitArena) {
+        SipmHitArena = new HitArena<SipmHit>;
     }
-    void* hit;
-    hit = (void*)SipmHitAllocator->MallocSingle();
-    return hit;
+    return SipmHitArena->Allocate();
 }
 
 inline void SipmHit::operator delete(void* hit)
 {
-    if (!SipmHitAllocator) {
-        SipmHitAllocator = new G4Allocator<SipmHit>;
-    }
-    SipmHitAllocator->FreeSingle((SipmHit*)hit);
+    SipmHitArena->Free(hit);
 }
 
 }  // namespace ZDC
@@ -27,8 +27,12 @@ class SipmSD : public G4VSensitiveDetector
     G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
     void EndOfEvent(G4HCofThisEvent* hitCollection) override;
 
+    // photon detected without tracking it to the SiPM (WLSFiberModel)
+    void AddPhotonHit(G4int sipmID, G4double time);
+
   private:
     SipmHitsCollection* fHitsCollection = nullptr;
+    std::size_t fLastNofHits = 0;
 };
 
 }  // namespace ZDC
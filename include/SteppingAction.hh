@@ -0,0 +1,36 @@
+#ifndef ZDCSteppingAction_h
+#define ZDCSteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+
+class G4ParticleDefinition;
+
+namespace ZDC
+{
+
+class EventAction;
+
+/// Kills the tracks above the time cut or below the kinetic-energy cut of
+/// their region (RegionInformation), e.g. the slow neutrons bouncing in the
+/// absorbers long after the SiPM gate. The kinetic energy of the killed
+/// tracks goes to the E.Cut column to monitor the bias.
+
+class SteppingAction : public G4UserSteppingAction
+{
+  public:
+    explicit SteppingAction(EventAction* eventAction);
+    ~SteppingAction() override = default;
+
+    void UserSteppingAction(const G4Step* step) override;
+
+  private:
+    EventAction* fEventAction;
+    const G4ParticleDefinition* fNeutron;
+    const G4ParticleDefinition* fOpticalPhoton;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
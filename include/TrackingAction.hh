@@ -3,6 +3,8 @@
 
 #include "G4UserTrackingAction.hh"
 
+class G4ParticleDefinition;
+
 namespace ZDC {
 
 class EventAction; //必须包含在ZDC namespace中
@@ -18,6 +20,9 @@ class TrackingAction : public G4UserTrackingAction
 
     private:
       EventAction*  fEventAction;
+      // compared by pointer, the definitions are singletons
+      const G4ParticleDefinition* fOpticalPhoton;
+      const G4ParticleDefinition* fPi0;
 };
 
 }
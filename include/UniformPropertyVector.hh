@@ -0,0 +1,46 @@
+#ifndef ZDCUniformPropertyVector_h
+#define ZDCUniformPropertyVector_h 1
+
+#include "G4MaterialPropertyVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace ZDC
+{
+
+/// Material property vector on a uniform energy grid.
+///
+/// Create() resamples the points (linear interpolation) onto bins of about
+/// the requested width over the original energy range. A uniform vector is
+/// flagged as a linear vector, so G4PhysicsVector::Value() computes the bin
+/// as (e - emin) / width instead of a binary search over the points; the
+/// optical processes use it through the plain G4MaterialPropertyVector
+/// interface. Points that are already uniform are kept, a zero bin width
+/// keeps irregular points as they are.
+///
+/// InsertValues() would break the grid, do not add points afterwards.
+
+class UniformPropertyVector : public G4MaterialPropertyVector
+{
+  public:
+    static UniformPropertyVector* Create(std::vector<G4double> energies, std::vector<G4double> values,
+                                         G4double binWidth);
+
+    ~UniformPropertyVector() override = default;
+
+    G4bool IsUniform() const { return type == T_G4PhysicsLinearVector; }
+
+    // resample a piecewise linear spectrum onto a uniform grid, in place
+    static void Resample(std::vector<G4double>& energies, std::vector<G4double>& values,
+                         G4double binWidth);
+
+  private:
+    UniformPropertyVector(const std::vector<G4double>& energies, const std::vector<G4double>& values);
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef ZDCWLSFiberModel_h
+#define ZDCWLSFiberModel_h 1
+
+#include "G4MaterialPropertyVector.hh"
+#include "G4ThreeVector.hh"
+#include "G4VFastSimulationModel.hh"
+#include "globals.hh"
+
+#include <unordered_map>
+
+class G4MaterialPropertiesTable;
+class G4Region;
+
+namespace ZDC
+{
+
+class SipmSD;
+
+/// Fast transport of optical photons trapped in the WLS fiber core.
+///
+/// The envelope is the <sector>_Fiber region (WLSLogical_k, the core inside
+/// clad1, clad2 and the hole, with the mirror at -z and the SiPM at +z of
+/// the hole). A photon is taken over on its first step in the core, i.e.
+/// when it is emitted there (WLS, Cerenkov), if its axial angle traps it by
+/// total internal reflection at the outer cladding as a meridional ray,
+/// n_core cos(theta) > n_clad2; skew rays trapped at larger angles and
+/// cladding modes stay with the normal tracking.
+///
+/// The photon then travels along the fiber with path length dz / cos(theta)
+/// at the group velocity. It is absorbed (ABSLENGTH) or WLS-absorbed
+/// (WLSABSLENGTH) on the way, in which case the WLS photons are re-emitted
+/// as secondaries (WLSCOMPONENT, WLSTIMECONSTANT), reflected by the mirror
+/// (REFLECTIVITY of the mirror surface) and absorbed by the SiPM with the
+/// REFLECTIVITY and EFFICIENCY of the SiPM surface. A detected photon is
+/// added to the SiPM hits directly, with the SiPM ID of the full tracking.
+
+class WLSFiberModel : public G4VFastSimulationModel
+{
+  public:
+    WLSFiberModel(const G4String& name, G4Region* envelope);
+    ~WLSFiberModel() override = default;
+
+    G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+    G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+    void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+  private:
+    void EmitWLSPhotons(G4FastStep& fastStep, const G4MaterialPropertiesTable* coreTable, G4double energy,
+                        const G4ThreeVector& position, G4double time);
+    G4double MaxValue(const G4MaterialPropertyVector* vector);
+
+    SipmSD* fSipmSD = nullptr;
+    std::unordered_map<const G4MaterialPropertyVector*, G4double> fMaxValues;
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef ZDCWorkerInitialization_h
+#define ZDCWorkerInitialization_h 1
+
+#include "G4UserWorkerInitialization.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace ZDC
+{
+
+/// Pins the worker threads to logical CPUs (exampleZDC --pin).
+///
+/// The CPUs the process may run on are grouped by NUMA node (by socket
+/// when the kernel reports no nodes) once, on the master:
+///  compact: worker i on the i-th CPU, filling a node before the next one
+///  scatter: the workers dealt round-robin over the nodes
+/// A worker pins itself in WorkerInitialize(), before its run manager and
+/// its thread-local allocators exist, then reserves the first block of the
+/// hit arenas, so that their memory is placed on the node of its CPU.
+/// Linux only, elsewhere the workers are left unpinned.
+
+class WorkerInitialization : public G4UserWorkerInitialization
+{
+  public:
+    explicit WorkerInitialization(const G4String& mode);
+    ~WorkerInitialization() override = default;
+
+    void WorkerInitialize() const override;
+
+  private:
+    G4String fMode;
+    std::vector<G4int> fCpus;     // CPU of worker i % size
+    std::vector<G4int> fDomains;  // and its node
+};
+
+}  // namespace ZDC
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
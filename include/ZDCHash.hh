@@ -0,0 +1,49 @@
+#ifndef ZDCHash_h
+#define ZDCHash_h 1
+
+#include "globals.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace ZDC
+{
+
+/// 64-bit FNV-1a hash, used for the cache keys of the overlap checker
+/// and of the physics tables
+
+class Fnv1a
+{
+  public:
+    void Add(const void* data, std::size_t n)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < n; i++) {
+            fHash ^= bytes[i];
+            fHash *= 1099511628211ULL;
+        }
+    }
+    void Add(const std::string& s) { Add(s.data(), s.size()); }
+    void Add(G4double v) { Add(&v, sizeof(v)); }
+    void Add(G4int v) { Add(&v, sizeof(v)); }
+    void Add(std::uint64_t v) { Add(&v, sizeof(v)); }
+
+    std::uint64_t Value() const { return fHash; }
+
+    // 16 hex digits
+    std::string Hex() const
+    {
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(fHash));
+        return hex;
+    }
+
+  private:
+    std::uint64_t fHash = 14695981039346656037ULL;
+};
+
+}  // namespace ZDC
+
+#endif
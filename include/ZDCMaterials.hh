@@ -17,21 +17,40 @@ class ZDCMaterials
 public:
     virtual ~ZDCMaterials();
 
+    // thread-safe, the materials and surfaces are built on the first call only
     static ZDCMaterials *GetInstance();
 
+    // verbose level of the material creation, set before the first GetInstance()
+    // 0: quiet, 1: NIST manager, 2: also dump the optical property tables
+    static void SetVerbose(G4int verbose) { fVerbose = verbose; }
+
+    // directory with the optical property files and energy bin width of the
+    // resampled spectra (see OpticalDataReader), set before the first GetInstance()
+    static void SetOpticalDataDir(const G4String& directory) { fOpticalDataDir = directory; }
+    static void SetOpticalBinWidth(G4double binWidth) { fOpticalBinWidth = binWidth; }
+
     G4Material *GetMaterial(const G4String);
 
     G4OpticalSurface *GetTyvekSurface() { return TyvekSurface; }  // surface 需要用函数获得
     G4OpticalSurface *GetPMTSurface() { return PMTSurface; }
     G4OpticalSurface *GetSipmSurface() { return SipmSurface; }
+    G4OpticalSurface *GetScinAirSurface() { return ScinAirSurface; }
+    G4OpticalSurface *GetFiberSurface() { return FiberSurface; }
+    G4OpticalSurface *GetTiO2Surface() { return TiO2Surface; }
+    G4OpticalSurface *GetMirrorSurface() { return MirrorSurface; }
 
 private:
     ZDCMaterials();
 
+    void DefineNistMaterials();
     void CreateMaterials();
+    void CreateSurfaces();
 
 private:
     static ZDCMaterials *fInstance;
+    static G4int fVerbose;
+    static G4String fOpticalDataDir;
+    static G4double fOpticalBinWidth;
 
     G4NistManager *fNistMan;
 
@@ -58,6 +77,10 @@ private:
     G4OpticalSurface* TyvekSurface;
     G4OpticalSurface* SipmSurface;
     G4OpticalSurface* PMTSurface;
+    G4OpticalSurface* ScinAirSurface;
+    G4OpticalSurface* FiberSurface;
+    G4OpticalSurface* TiO2Surface;
+    G4OpticalSurface* MirrorSurface;
 };
 }
 #endif /*ZDCMaterials_h*/
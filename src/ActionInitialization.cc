@@ -3,6 +3,7 @@
 #include "EventAction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "SteppingAction.hh"
 #include "TrackingAction.hh"
 
 using namespace ZDC;
@@ -28,6 +29,7 @@ void ActionInitialization::Build() const
     SetUserAction(eventAction);
     SetUserAction(new RunAction(eventAction));
     SetUserAction(new TrackingAction(eventAction));
+    SetUserAction(new SteppingAction(eventAction));
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -5,7 +5,6 @@
 #include "G4Colour.hh"
 #include "G4VisAttributes.hh"
 
-#include "G4Allocator.hh"
 #include "G4VHit.hh"
 #include "G4ios.hh"
 
@@ -14,7 +13,7 @@
 namespace ZDC
 {
 
-G4ThreadLocal G4Allocator<CalorHit>* CalorHitAllocator = nullptr;
+G4ThreadLocal HitArena<CalorHit>* CalorHitArena = nullptr;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -4,10 +4,12 @@
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
 #include "G4SDManager.hh"
+#include "G4RunManager.hh"
 #include "G4ios.hh"
 
 #include "EventAction.hh"
 #include "DetectorConstruction.hh"
+#include "DetectorID.hh"
 #include "RunAction.hh"
 
 namespace ZDC
@@ -25,13 +27,26 @@ CalorimeterSD::CalorimeterSD(const G4String& name, const G4String& hitsCollectio
 
 void CalorimeterSD::Initialize(G4HCofThisEvent* hce)
 {
-    // Create hits collection
+    // Create hits collection, sized like the previous event's
     fHitsCollection = new CalorHitsCollection(SensitiveDetectorName, collectionName[0]);
+    fHitsCollection->GetVector()->reserve(fLastNofHits);
 
     // Add this collection in hce
     auto hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
     hce->AddHitsCollection(hcID, fHitsCollection);
 
+    // cell arrays of the current geometry, O(cells) per event
+    auto detector = static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fCellMode = detector->GetCalorCellMode();
+    for (G4int i = 0; i < kNCellSector; i++) {
+        G4bool used = fCellMode && (i < NSector || UsePbWO4EMCal);
+        fCellNLayer[i] = used ? detector->GetNLayer(i) : 0;
+        std::size_t nCell = used ? detector->GetNModule(i) * detector->GetNModule(i) * fCellNLayer[i] : 0;
+        fCellEdepSen[i].assign(nCell, 0.);
+        fCellEdepAbs[i].assign(nCell, 0.);
+        fCellTime[i].assign(nCell, -1.);
+    }
+
   // Create hits
   // fNofCells for cells + one more for total sums
 //  for (G4int i = 0; i < fNofCells + 1; i++) {
@@ -59,6 +74,30 @@ G4bool CalorimeterSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 
     if (edep == 0. && stepLength == 0.) return false;
 
+    if (fCellMode) {
+        if (edep == 0.) return false;
+        const G4VTouchable* touchable = step->GetPreStepPoint()->GetTouchable();
+        G4int detectorID = 0;
+        for (G4int i = 0; i < touchable->GetHistoryDepth(); i++) detectorID += touchable->GetCopyNumber(i);
+
+        const DetInfo id = DecodeDetectorID(detectorID);
+        if (id.sector < 0 || id.sector >= kNCellSector || id.module < 0 || id.layer >= fCellNLayer[id.sector])
+            return false;
+        const std::size_t cell = id.module * fCellNLayer[id.sector] + id.layer;
+        if (cell >= fCellEdepSen[id.sector].size()) return false;
+
+        if (id.type == kSensitiveType) {
+            fCellEdepSen[id.sector][cell] += edep;
+            G4double time = step->GetPreStepPoint()->GetGlobalTime();
+            G4double& firstTime = fCellTime[id.sector][cell];
+            if (firstTime < 0. || time < firstTime) firstTime = time;
+        }
+        else if (id.type == kAbsorberType) {
+            fCellEdepAbs[id.sector][cell] += edep;
+        }
+        return true;
+    }
+
     G4StepPoint *preStepPoint = step->GetPreStepPoint();
     G4StepPoint *postStepPoint = step->GetPostStepPoint();
     G4TouchableHandle theTouchable = preStepPoint->GetTouchableHandle();
@@ -68,9 +107,6 @@ G4bool CalorimeterSD::ProcessHits(G4Step* step, G4TouchableHistory*)
     G4int TrackID = theTrack->GetTrackID();
     G4int ParentTrackID = theTrack->GetParentID();
 
-    G4String currentPhysicalName = step->GetPreStepPoint()->GetPhysicalVolume()->GetName();
-    G4String particleName = step->GetTrack()->GetDefinition()->GetParticleName();
-
     G4int DetectorID = 0;
 
     for (G4int i = 0; i < theTouchable->GetHistoryDepth(); i++)
@@ -132,8 +168,6 @@ G4bool CalorimeterSD::ProcessHits(G4Step* step, G4TouchableHistory*)
         aHit->SetTrackLength(stepLength);
         aHit->SetPhysV(thePhysVol);
         aHit->SetCopyNo(CopyNo);
-	    aHit->SetPhysVolName(currentPhysicalName);
-	    aHit->SetParticleName(particleName);
         fHitsCollection->insert(aHit);
     }
     
@@ -144,6 +178,8 @@ G4bool CalorimeterSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 
 void CalorimeterSD::EndOfEvent(G4HCofThisEvent*)
 {
+    fLastNofHits = fHitsCollection->entries();
+
     if (verboseLevel > 1) {
         auto nofHits = fHitsCollection->entries();
         G4cout << G4endl << "-------->Hits Collection: in this event they are " << nofHits
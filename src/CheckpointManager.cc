@@ -0,0 +1,222 @@
+#include "CheckpointManager.hh"
+#include "CheckpointMessenger.hh"
+
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4Timer.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+const G4String kMagic = "ZDCCheckpoint";
+constexpr G4int kVersion = 1;
+}  // namespace
+
+CheckpointManager* CheckpointManager::fInstance = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointManager::CheckpointManager()
+{
+    fInstance = this;
+    fMessenger = new CheckpointMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointManager::~CheckpointManager()
+{
+    delete fMessenger;
+    fInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::SetOutputBase(const G4String& base)
+{
+    fOutputBase = base;
+    fOutputFileName = base + ".root";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CheckpointManager::Resume(const G4String& fileName)
+{
+    std::ifstream in(fileName);
+    G4String tag, key;
+    G4int version = 0;
+    if (in >> tag >> version && tag == kMagic && version == kVersion) {
+        while (in >> key && key != "Engine") {
+            if (key == "Events") in >> fTotal;
+            else if (key == "Done") in >> fDone;
+            else if (key == "Part") in >> fPart;
+        }
+    }
+    if (key != "Engine" || fDone < 0 || fDone > fTotal) {
+        G4ExceptionDescription msg;
+        msg << "Cannot read checkpoint " << fileName;
+        G4Exception("CheckpointManager::Resume()", "MyCode0018", FatalException, msg);
+        return false;
+    }
+    in >> std::ws;
+    fEngineState.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    fFileName = fileName;
+    fResumed = true;
+    fResumedEvents = fDone;
+    G4cout << "Resuming " << fileName << ": " << fDone << " of " << fTotal << " events done, next part " << fPart
+           << G4endl;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::BeamOn(G4int nEvents)
+{
+    auto runManager = G4RunManager::GetRunManager();
+    if (!fResumed && fEveryEvents <= 0 && fEveryMinutes <= 0.) {
+        runManager->BeamOn(nEvents);
+        return;
+    }
+
+    if (fResumed) {
+        if (nEvents != fTotal) {
+            G4ExceptionDescription msg;
+            msg << "/ckpt/BeamOn " << nEvents << " resumed from a run of " << fTotal << " events, " << fTotal
+                << " are kept.";
+            G4Exception("CheckpointManager::BeamOn()", "MyCode0018", JustWarning, msg);
+        }
+        // the master engine seeds the events of the next part
+        std::istringstream engine(fEngineState);
+        if (!G4Random::getTheEngine()->get(engine)) {
+            G4Exception("CheckpointManager::BeamOn()", "MyCode0018", FatalException,
+                        "The checkpoint holds the state of another random engine.");
+            return;
+        }
+        fResumed = false;
+    }
+    else {
+        fTotal = nEvents;
+        fDone = 0;
+        fPart = 0;
+    }
+
+    G4double secondsPerEvent = 0.;
+    while (fDone < fTotal) {
+        G4int size = NextPartSize(secondsPerEvent);
+        fEventOffset = fDone;
+        fOutputFileName = fOutputBase + "_" + std::to_string(fPart) + ".root";
+
+        G4Timer timer;
+        timer.Start();
+        runManager->BeamOn(size);
+        timer.Stop();
+
+        auto run = runManager->GetCurrentRun();
+        G4int processed = run ? run->GetNumberOfEvent() : 0;
+        fDone += processed;
+        fPart++;
+        Save();
+
+        if (processed < size) {
+            G4ExceptionDescription msg;
+            msg << "Part " << fPart - 1 << " aborted after " << processed << " of " << size << " events, "
+                << fTotal - fDone << " events left in " << GetFileName();
+            G4Exception("CheckpointManager::BeamOn()", "MyCode0018", JustWarning, msg);
+            break;
+        }
+        secondsPerEvent = timer.GetRealElapsed() / processed;
+    }
+
+    // back to plain runs
+    fEventOffset = 0;
+    fOutputFileName = fOutputBase + ".root";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int CheckpointManager::NextPartSize(G4double secondsPerEvent) const
+{
+    G4long size = fTotal - fDone;
+    if (fEveryEvents > 0) size = std::min<G4long>(size, fEveryEvents);
+    if (fEveryMinutes > 0. && secondsPerEvent > 0.)
+        size = std::min(size, std::max<G4long>(1, G4long(fEveryMinutes * 60. / secondsPerEvent)));
+    else if (fEveryMinutes > 0. && fEveryEvents <= 0)
+        size = std::min<G4long>(size, kProbeEvents);
+    return G4int(size);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::Save() const
+{
+    // written aside and renamed, a preemption leaves the previous checkpoint
+    const G4String fileName = GetFileName();
+    const G4String tmpName = fileName + ".tmp";
+    {
+        std::ofstream out(tmpName);
+        out << kMagic << " " << kVersion << "\n"
+            << "Events " << fTotal << "\n"
+            << "Done " << fDone << "\n"
+            << "Part " << fPart << "\n"
+            << "Engine\n";
+        G4Random::getTheEngine()->put(out);
+        if (!out) {
+            G4ExceptionDescription msg;
+            msg << "Cannot write checkpoint " << tmpName;
+            G4Exception("CheckpointManager::Save()", "MyCode0018", JustWarning, msg);
+            return;
+        }
+    }
+    if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+        G4ExceptionDescription msg;
+        msg << "Cannot replace checkpoint " << fileName;
+        G4Exception("CheckpointManager::Save()", "MyCode0018", JustWarning, msg);
+        return;
+    }
+    G4cout << "Checkpoint " << fileName << ": " << fDone << " of " << fTotal << " events in " << fPart
+           << " part(s)" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::SetNewValueInt(const G4String& key, G4int value)
+{
+    if (key == "EveryEvents") fEveryEvents = value;
+    else return;
+    G4cout << "Set " << key << " value in CheckpointManager = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::SetNewValueDouble(const G4String& key, G4double value)
+{
+    if (key == "EveryMinutes") fEveryMinutes = value;
+    else return;
+    G4cout << "Set " << key << " value in CheckpointManager = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointManager::SetNewValueString(const G4String& key, const G4String& value)
+{
+    // a resumed run keeps writing the checkpoint it was started from
+    if (key == "File" && !fResumed) fFileName = value;
+    else return;
+    G4cout << "Set " << key << " value in CheckpointManager = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
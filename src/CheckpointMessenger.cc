@@ -0,0 +1,85 @@
+#include "CheckpointMessenger.hh"
+
+#include "CheckpointManager.hh"
+
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithALongInt.hh"
+#include "G4UIdirectory.hh"
+
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointMessenger::CheckpointMessenger(CheckpointManager* manager) : fCheckpointManager(manager)
+{
+  // master only, the workers run the parts
+  fCkptDirectory = new G4UIdirectory("/ckpt/", false);
+  fCkptDirectory->SetGuidance("Checkpointed runs, resumed with exampleZDC --resume <file>");
+
+  fFile = new G4UIcmdWithAString("/ckpt/File", this);
+  fFile->SetGuidance("Checkpoint file, rewritten after every part (default <output base>.ckpt, i.e. ZDC.ckpt).");
+  fFile->SetParameterName("file", false);
+  fFile->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFile->SetToBeBroadcasted(false);
+
+  fEveryEvents = new G4UIcmdWithALongInt("/ckpt/EveryEvents", this);
+  fEveryEvents->SetGuidance("Events per part, each part writes ZDC_<part>.root and the checkpoint; 0 for no limit.");
+  fEveryEvents->SetParameterName("n", false);
+  fEveryEvents->SetRange("n >= 0");
+  fEveryEvents->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEveryEvents->SetToBeBroadcasted(false);
+
+  fEveryMinutes = new G4UIcmdWithADouble("/ckpt/EveryMinutes", this);
+  fEveryMinutes->SetGuidance("Length of a part in minutes, from the event rate of the previous part; 0 for no limit.");
+  fEveryMinutes->SetParameterName("minutes", false);
+  fEveryMinutes->SetRange("minutes >= 0");
+  fEveryMinutes->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEveryMinutes->SetToBeBroadcasted(false);
+
+  fBeamOn = new G4UIcmdWithALongInt("/ckpt/BeamOn", this);
+  fBeamOn->SetGuidance("Run the events in parts with a checkpoint after each, or continue the resumed run.");
+  fBeamOn->SetGuidance("Without /ckpt/EveryEvents and /ckpt/EveryMinutes the same as /run/beamOn.");
+  fBeamOn->SetParameterName("nEvents", false);
+  fBeamOn->SetRange("nEvents > 0");
+  fBeamOn->AvailableForStates(G4State_Idle);
+  fBeamOn->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointMessenger::~CheckpointMessenger()
+{
+  delete fFile;
+  delete fEveryEvents;
+  delete fEveryMinutes;
+  delete fBeamOn;
+  delete fCkptDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fFile) {
+    fCheckpointManager->SetNewValueString("File", newValue);
+  }
+
+  if (command == fEveryEvents) {
+    fCheckpointManager->SetNewValueInt("EveryEvents", fEveryEvents->GetNewLongIntValue(newValue));
+  }
+
+  if (command == fEveryMinutes) {
+    fCheckpointManager->SetNewValueDouble("EveryMinutes", fEveryMinutes->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fBeamOn) {
+    fCheckpointManager->BeamOn(fBeamOn->GetNewLongIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
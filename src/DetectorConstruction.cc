@@ -49,7 +49,13 @@
 #include "DetectorConstruction.hh"
 #include "CalorimeterSD.hh"
 #include "SiPMSD.hh"
+#include "LeakageSD.hh"
+#include "RegionInformation.hh"
+#include "SDFilter.hh"
+#include "WLSFiberModel.hh"
 #include "DetectorMessenger.hh"
+#include "ZDCHash.hh"
+#include "Logger.hh"
 
 #include "ZDCMaterials.hh"
 #include "G4VisAttributes.hh"
@@ -72,10 +78,20 @@
 #include "G4PVParameterised.hh"
 #include "G4PVReplica.hh"
 #include "G4UserLimits.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UImanager.hh"
+#include "G4StateManager.hh"
 
 #include "G4SDManager.hh"
 #include "G4VSensitiveDetector.hh"
 #include "G4RunManager.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4FastSimulationPhysics.hh"
 #include "G4GenericMessenger.hh"
 
 #include "G4Colour.hh"
@@ -86,22 +102,45 @@
 #include "G4LogicalBorderSurface.hh"
 #include "G4LogicalSkinSurface.hh"
 #include "G4OpticalSurface.hh"
+#include "G4SurfaceProperty.hh"
+#include "G4Version.hh"
 
 #include "G4GlobalMagFieldMessenger.hh"
 #include "G4AutoDelete.hh"
 
 #include "G4PhysicalConstants.hh"
 
+#ifdef ZDC_USE_GDML
+#include "G4GDMLParser.hh"
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+
+#include <unistd.h>
+
 namespace ZDC
 {
 
 DetectorConstruction::DetectorConstruction() : G4VUserDetectorConstruction()
 {
+    // deleted here, the G4SDManager does not own the filters
+    for (G4String sd : {"AbsorberSD1", "SipmSD2"}) fSDFilters[sd] = new SDFilter(sd + "Filter");
+
     fMessenger = new DetectorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+DetectorConstruction::~DetectorConstruction()
+{
+    for (const auto& [sd, filter] : fSDFilters) delete filter;
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 G4ThreadLocal G4GlobalMagFieldMessenger* DetectorConstruction::fMagFieldMessenger = nullptr;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -115,7 +154,6 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 //  return DefineVolumes();
 
   // Define materials 
-    fMaterials = ZDCMaterials::GetInstance(); // initilize the material
     DefineMaterials();
 
     auto air = G4Material::GetMaterial("G4_AIR");
@@ -148,8 +186,18 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     vShashHoleLength = vShashFiberLength + 1*cm;
     vShashRodLength = vShashModuleLength + 1*cm;
 
-    // Option to switch on/off checking of volumes overlaps
-    G4bool checkOverlaps = false;
+    // GDML copy of the same geometry from an earlier build (/det/GeometryCache)
+    const G4String cacheFile = GetGeometryCacheFile();
+    if (!cacheFile.empty()) {
+        if (auto world = ReadGDML(cacheFile)) {
+            SetupRegions();
+            return world;
+        }
+    }
+
+    // Option to switch on/off checking of volumes overlaps (/det/CheckOverlaps),
+    // zdc_check_geometry checks the whole geometry in parallel instead
+    G4bool checkOverlaps = fCheckOverlaps;
     // geometries --------------------------------------------------------------
     // experimental hall (world volume)
     auto worldSolid = new G4Box("worldBox", 100. * cm, 100. * cm, 250 * cm);
@@ -171,9 +219,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
             G4double x_layer = -vEMArraySizeXY / 2 * (vNEMc - 1) + G4int(i % vNEMc) * vEMArraySizeXY;
             G4double y_layer = -vEMArraySizeXY / 2 * (vNEMc - 1) + G4int(i / vNEMc) * vEMArraySizeXY;
 		    G4double z_layer = CurrentZPos;
-            EM_fArray_Phy = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), EM_array_LV, "EMLayer", worldLogical, false, (i+1)*10000+4000000);
+            EM_fArray_Phy = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), EM_array_LV, "EMLayer", worldLogical, false, (i+1)*10000+4000000, checkOverlaps);
         }
-        G4cout << "Placed physical volume: " << EM_fArray_Phy->GetName() << G4endl;
+        Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + EM_fArray_Phy->GetName());
 
         // filled with crystal
         auto fCrysSolid_EM = new G4Box("CrysBox_EM", vEMSize / 2., vEMSize / 2., vEMLength / 2.);
@@ -186,7 +234,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         auto fCoatingSolid_EM = new G4SubtractionSolid("CoatingBox_EM", fCoatingSolid_original_EM, fCoatingSolid_sub_EM);
         fCoatingLogical_EM = new G4LogicalVolume(fCoatingSolid_EM, tyvek, "CoatingLogical_EM");
         G4VPhysicalVolume *fCoatingPhysical_EM = new G4PVPlacement(0, G4ThreeVector(0, 0, 0*cm), fCoatingLogical_EM, "CoatingPhysical_EM", EM_array_LV, false, 1, checkOverlaps);
-        G4cout << "Placed physical volume: " << fCoatingPhysical_EM->GetName() << G4endl;
+        Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fCoatingPhysical_EM->GetName());
 
         // (PMT or Sipm)
         auto fPMTSolid_EM = new G4Tubs("PMTTubs_EM", 0., kEMPMTSize / 2., kEMPMTThick / 2., 0, 360);
@@ -198,6 +246,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     //G4double vWSciModuleLength = vNWSciLayer*(vWSciWThick + vWSciSciThick + 2.*kWSciLayerGap);
     G4double WSciBoxLength = (vWSciModuleLength/2+4*cm)*2.;
     CurrentZPos += EmcLVBoxLength/2. + SectorBoxGap + WSciBoxLength/2.;
+    G4double WSciZMin = CurrentZPos - WSciBoxLength/2.;
     G4Box *fArray_Box_WSci = new G4Box("Array_box_WSci", vWSciArraySize / 2, vWSciArraySize / 2, WSciBoxLength/2.); // its size
     G4LogicalVolume *array_LV_WSci = new G4LogicalVolume(fArray_Box_WSci, air, "Array_LV_WSci");
     G4VPhysicalVolume *fArray_Phy_WSci;
@@ -205,10 +254,10 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double x_layer = -vWSciArraySize / 2 * (vNWSci - 1) + G4int(i % vNWSci) * vWSciArraySize;
         G4double y_layer = -vWSciArraySize / 2 * (vNWSci - 1) + G4int(i / vNWSci) * vWSciArraySize;
         G4double z_layer = CurrentZPos;
-        fArray_Phy_WSci = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), array_LV_WSci, "LayerWSci", worldLogical, false, (i+1)*10000+3000000);
+        fArray_Phy_WSci = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), array_LV_WSci, "LayerWSci", worldLogical, false, (i+1)*10000+3000000, checkOverlaps);
 
     }
-    G4cout << "Placed physical volume: " << fArray_Phy_WSci->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fArray_Phy_WSci->GetName());
 
     // the TiO2 coating
     auto fCoatingSolid_original_0 = new G4Box("CoatingBox_original_0", vWSciArraySize / 2., vWSciArraySize / 2., vWSciModuleLength / 2.0 + kWSciModuleGap);
@@ -216,7 +265,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     auto fCoatingSolid_0 = new G4SubtractionSolid("CoatingBox_0", fCoatingSolid_original_0, fCoatingSolid_sub_0);
     fCoatingLogical_0 = new G4LogicalVolume(fCoatingSolid_0, TiO2, "CoatingLogical_0");
     G4VPhysicalVolume *fCoatingPhysical_0 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fCoatingLogical_0, "CoatingPhysical_0", array_LV_WSci, false, 1, checkOverlaps);
-    G4cout << "Placed physical volume: " << fCoatingPhysical_0->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fCoatingPhysical_0->GetName());
         
     auto fWSolid = new G4Box("WBox", vWSciSize / 2., vWSciSize / 2., vWSciWThick / 2.);
     fWSci_WLogical = new G4LogicalVolume(fWSolid, tungsten, "WLogical");
@@ -262,7 +311,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double y_hole = -(vWSciSize/2.0) + startOffset + row * step;
         // G4double x_hole = -(vWSciSize / 2.0) + vWSciSize / 8.0 + G4int(i % 4) * vWSciSize / 4.0;
         // G4double y_hole = -(vWSciSize / 2.0) + vWSciSize / 8.0 + G4int(i / 4) * vWSciSize / 4.0;
-        fHolePhysical_0 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_0, "HolePhysical_0", array_LV_WSci, false, i+10, false);
+        fHolePhysical_0 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_0, "HolePhysical_0", array_LV_WSci, false, i+10, checkOverlaps);
     }
 
     // Clad2
@@ -320,15 +369,15 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double z_RodHole = vShashModuleLength/2 - vShashModuleLength/2.;
         G4double x_RodHole = -(vWSciSize / 2.0) + vWSciSize / 4.0 + G4int(i % 2) * vWSciSize / 2.0;
         G4double y_RodHole = -(vWSciSize / 2.0) + vWSciSize / 4.0 + G4int(i / 2) * vWSciSize / 2.0;
-        fRodHolePhysical_0 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_0, "RodHolePhysical_0", array_LV_WSci, false, i+70, false);
+        fRodHolePhysical_0 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_0, "RodHolePhysical_0", array_LV_WSci, false, i+70, checkOverlaps);
     }
 
     // rod
     auto fRodSolid_0 = new G4Tubs("RodTubs_0", 0., kRodDiameter / 2., vWSciRodLength / 2., 0, 360);
     fRodLogical_0 = new G4LogicalVolume(fRodSolid_0, steel, "RodLogical_0");
     G4VPhysicalVolume *fRodPhysical_0 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fRodLogical_0, "RodPhysical_0", fRodHoleLogical_0, false, 7, checkOverlaps);
-    G4cout << "Placed physical volume: " << fRodSolid_0->GetName() << G4endl;
-    G4cout << "Placed physical volume: " << fRodPhysical_0->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodSolid_0->GetName());
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodPhysical_0->GetName());
 
     
     // ZDC Module
@@ -342,10 +391,10 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double x_layer = -vShashArraySizeXY / 2 * (vNShash- 1) + G4int(i % vNShash) * vShashArraySizeXY;
         G4double y_layer = -vShashArraySizeXY / 2 * (vNShash- 1) + G4int(i / vNShash) * vShashArraySizeXY;
 	    G4double z_layer = CurrentZPos;
-        fArray_Phy_1 = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), array_LV_1, "Layer1", worldLogical, false, (i+1)*10000+1000000);
+        fArray_Phy_1 = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer,  z_layer), array_LV_1, "Layer1", worldLogical, false, (i+1)*10000+1000000, checkOverlaps);
 
     }
-    G4cout << "Placed physical volume: " << fArray_Phy_1->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fArray_Phy_1->GetName());
 
     // the TiO2 coating
     auto fCoatingSolid_original_1 = new G4Box("CoatingBox_original_1", vShashArraySizeXY / 2., vShashArraySizeXY / 2., vShashModuleLength / 2.0);
@@ -353,7 +402,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     auto fCoatingSolid_1 = new G4SubtractionSolid("CoatingBox_1", fCoatingSolid_original_1, fCoatingSolid_sub_1);
     fCoatingLogical_1 = new G4LogicalVolume(fCoatingSolid_1, TiO2, "CoatingLogical_1");
     G4VPhysicalVolume *fCoatingPhysical_1 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fCoatingLogical_1, "CoatingPhysical_1", array_LV_1, false, 1, checkOverlaps);
-    G4cout << "Placed physical volume: " << fCoatingPhysical_1->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fCoatingPhysical_1->GetName());
 
     // lyaers /
     // front plate + (reflector + scintillator + reflector + lead) + back plate
@@ -362,7 +411,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     fFrontPlateLogical_1 = new G4LogicalVolume(fFrontPlateSolid_1, aluminum, "FrontPlateLogical_1");
     G4VPhysicalVolume *fFrontPlatePhysical_1 = 
     new G4PVPlacement(0, G4ThreeVector(0, 0, -vShashModuleLength / 2. - kFrontPlateThick/2.), fFrontPlateLogical_1, "FrontPlatePhysical_1", array_LV_1, false, 2, checkOverlaps);
-    G4cout << "Placed physical volume: " << fFrontPlatePhysical_1->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fFrontPlatePhysical_1->GetName());
 
     // scintillator layer
     auto fScinSolid_1 = new G4Box("ScinBox_1", vShashSize / 2., vShashSize / 2., vShashScinThick / 2.);
@@ -399,8 +448,8 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     G4VPhysicalVolume *fBackPlatePhysical_1 = 
     new G4PVPlacement(0, G4ThreeVector(0, 0, vShashModuleLength/2 + kBackPlateThick / 2.), fBackPlateLogical_1, "BackPlatePhysical_1", array_LV_1, false, 3, checkOverlaps);
 
-    G4cout << "Placed physical volume: " << fBackPlateSolid_1->GetName() << G4endl;
-    G4cout << "Placed physical volume: " << fBackPlatePhysical_1->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fBackPlateSolid_1->GetName());
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fBackPlatePhysical_1->GetName());
 
     // fibers
     // hole -> clad2 -> clad2 ->core
@@ -419,7 +468,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double z_hole = (kFiberBackLength - kFiberFrontLength) / 2.;
         // G4double x_hole = -(vShashSize / 2.0) + vShashSize / 8.0 + G4int(i % 4) * vShashSize / 4.0;
         // G4double y_hole = -(vShashSize / 2.0) + vShashSize / 8.0 + G4int(i / 4) * vShashSize / 4.0;
-        fHolePhysical_1 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_1, "HolePhysical_1", array_LV_1, false, i+10, false);
+        fHolePhysical_1 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_1, "HolePhysical_1", array_LV_1, false, i+10, checkOverlaps);
     }
 
     // Clad2
@@ -474,15 +523,15 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
             G4double z_RodHole = vShashModuleLength/2 - vShashModuleLength/2.;
             G4double x_RodHole = -(vShashSize / 2.0) + vShashSize / 4.0 + G4int(i % 2) * vShashSize / 2.0;
             G4double y_RodHole = -(vShashSize / 2.0) + vShashSize / 4.0 + G4int(i / 2) * vShashSize / 2.0;
-            fRodHolePhysical_1 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_1, "RodHolePhysical_1", array_LV_1, false, i+70, false);
+            fRodHolePhysical_1 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_1, "RodHolePhysical_1", array_LV_1, false, i+70, checkOverlaps);
     }
 
     // rod
     auto fRodSolid_1 = new G4Tubs("RodTubs_1", 0., kRodDiameter / 2., vShashRodLength / 2., 0, 360);
     fRodLogical_1 = new G4LogicalVolume(fRodSolid_1, steel, "RodLogical_1");
     G4VPhysicalVolume *fRodPhysical_1 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fRodLogical_1, "RodPhysical_1", fRodHoleLogical_1, false, 7, checkOverlaps);
-    G4cout << "Placed physical volume: " << fRodSolid_1->GetName() << G4endl;
-    G4cout << "Placed physical volume: " << fRodPhysical_1->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodSolid_1->GetName());
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodPhysical_1->GetName());
 
 ////////////////// Make a second Copy:
     // module array; notice: array length is twice of module, aim to put the front layer in center
@@ -494,9 +543,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double x_layer = -vShashArraySizeXY / 2 * (vNShash- 1) + G4int(i % vNShash) * vShashArraySizeXY;
         G4double y_layer = -vShashArraySizeXY / 2 * (vNShash- 1) + G4int(i / vNShash) * vShashArraySizeXY;
 	    G4double z_layer = CurrentZPos;
-        fArray_Phy_2 = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer, z_layer), array_LV_2, "Layer2", worldLogical, false, (i+1)*10000+2000000);
+        fArray_Phy_2 = new G4PVPlacement(0, G4ThreeVector(x_layer, y_layer, z_layer), array_LV_2, "Layer2", worldLogical, false, (i+1)*10000+2000000, checkOverlaps);
     }
-    G4cout << "Placed physical volume: " << fArray_Phy_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fArray_Phy_2->GetName());
 
     // the TiO2 coating
     auto fCoatingSolid_original_2 = new G4Box("CoatingBox_original_2", vShashArraySizeXY / 2., vShashArraySizeXY / 2., vShashModuleLength / 2.0);
@@ -504,7 +553,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     auto fCoatingSolid_2 = new G4SubtractionSolid("CoatingBox_2", fCoatingSolid_original_2, fCoatingSolid_sub_2);
     fCoatingLogical_2 = new G4LogicalVolume(fCoatingSolid_2, TiO2, "CoatingLogical_2");
     G4VPhysicalVolume *fCoatingPhysical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fCoatingLogical_2, "CoatingPhysical_2", array_LV_2, false, 1, checkOverlaps);
-    G4cout << "Placed physical volume: " << fCoatingPhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fCoatingPhysical_2->GetName());
 
     // layers
     // front plate + (reflector + scintillator + reflector + lead) + back plate
@@ -513,7 +562,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     fFrontPlateLogical_2 = new G4LogicalVolume(fFrontPlateSolid_2, aluminum, "FrontPlateLogical_2");
     G4VPhysicalVolume *fFrontPlatePhysical_2 = 
     new G4PVPlacement(0, G4ThreeVector(0, 0, kFrontPlateThick / 2. - vShashModuleLength / 2.), fFrontPlateLogical_2, "FrontPlatePhysical_2", array_LV_2, false, 2, checkOverlaps);
-    G4cout << "Placed physical volume: " << fFrontPlatePhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fFrontPlatePhysical_2->GetName());
 
     // scintillator layer
     auto fScinSolid_2 = new G4Box("ScinBox_2", vShashSize / 2., vShashSize / 2., vShashScinThick / 2.);
@@ -523,7 +572,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double z_scin = (vShashScinThick + vShashLeadThick + kReflectorThick * 2.0) * i + kReflectorThick + vShashLeadThick + kFrontPlateThick + vShashScinThick / 2.0 -vShashModuleLength / 2.;
         fScinPhysical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, z_scin), fScinLogical_2, "ScinPhysical_2", array_LV_2, false, i*10+1000, checkOverlaps);
     }
-    G4cout << "Placed physical volume: " << fScinPhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fScinPhysical_2->GetName());
 
     // lead
     auto fLeadSolid_2 = new G4Box("LeadBox", vShashSize / 2., vShashSize / 2., vShashLeadThick / 2.);
@@ -550,9 +599,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     fBackPlateLogical_2 = new G4LogicalVolume(fFrontPlateSolid_2, aluminum, "BackPlateLogical_2");
     G4VPhysicalVolume *fBackPlatePhysical_2 = 
     new G4PVPlacement(0, G4ThreeVector(0, 0, vShashModuleLength/2 - kBackPlateThick / 2.), fBackPlateLogical_2, "BackPlatePhysical_2", array_LV_2, false, 3, checkOverlaps);
-    G4cout << "Placed physical volume: " << fBackPlateSolid_2->GetName() << G4endl;
-    G4cout << "Placed physical volume: " << fBackPlateLogical_2->GetName() << G4endl;
-    G4cout << "Placed physical volume: " << fBackPlatePhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fBackPlateSolid_2->GetName());
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fBackPlateLogical_2->GetName());
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fBackPlatePhysical_2->GetName());
 
     // fibers
     // hole -> clad2 -> clad2 ->core
@@ -571,27 +620,27 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double z_hole = (kFiberBackLength - kFiberFrontLength) / 2.;
         // G4double x_hole = -(vShashSize / 2.0) + vShashSize / 8.0 + G4int(i % 4) * vShashSize / 4.0;
         // G4double y_hole = -(vShashSize / 2.0) + vShashSize / 8.0 + G4int(i / 4) * vShashSize / 4.0;
-        fHolePhysical_2 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_2, "HolePhysical_2", array_LV_2, false, i+10, false);
+        fHolePhysical_2 = new G4PVPlacement(0, G4ThreeVector(x_hole, y_hole, z_hole), fHoleLogical_2, "HolePhysical_2", array_LV_2, false, i+10, checkOverlaps);
     }
-    G4cout << "Placed physical volume: " << fHolePhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fHolePhysical_2->GetName());
 
     // Clad2
     auto fClad2Solid_2 = new G4Tubs("Clad2Tubs_2", 0, kFiberClad2Diameter / 2., vShashFiberLength / 2., 0, 360);
     fClad2Logical_2 = new G4LogicalVolume(fClad2Solid_2, clad2, "Clad2Logical_2");
     G4VPhysicalVolume *fClad2Physical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fClad2Logical_2, "Clad2Physical_2", fHoleLogical_2, false, 4, checkOverlaps);
-    G4cout << "Placed physical volume: " << fClad2Physical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fClad2Physical_2->GetName());
 
     //Clad1
     auto fClad1Solid_2 = new G4Tubs("Clad1Tubs_2", 0, kFiberClad1Diameter / 2., vShashFiberLength / 2., 0, 360);
     fClad1Logical_2 = new G4LogicalVolume(fClad1Solid_2, clad1, "Clad1Logical_2");
     G4VPhysicalVolume *fClad1Physical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fClad1Logical_2, "Clad1Physical_2", fClad2Logical_2, false, 5, checkOverlaps);
-    G4cout << "Placed physical volume: " << fClad1Physical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fClad1Physical_2->GetName());
 
     // fiber core
     auto fWLSSolid_2 = new G4Tubs("WLSTubs_2", 0., kFiberWLSDiameter / 2., vShashFiberLength / 2., 0, 360);
     fWLSLogical_2 = new G4LogicalVolume(fWLSSolid_2, WLS, "WLSLogical_2");
     G4VPhysicalVolume *fWLSPhysical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fWLSLogical_2, "WLSPhysical_2", fClad1Logical_2, false, 6, checkOverlaps);
-    G4cout << "Placed physical volume: " << fWLSPhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fWLSPhysical_2->GetName());
 
     // Mirror
     auto fMirrorSolid_2 = new G4Tubs("MirrorTubs_2", 0., kMirrorDiameter / 2., kMirrorThick / 2., 0, 360);
@@ -630,15 +679,64 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         G4double z_RodHole = 0;
         G4double x_RodHole = -(vShashSize / 2.0) + vShashSize / 4.0 + G4int(i % 2) * vShashSize / 2.0;
         G4double y_RodHole = -(vShashSize / 2.0) + vShashSize / 4.0 + G4int(i / 2) * vShashSize / 2.0;
-        fRodHolePhysical_2 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_2, "RodHolePhysical_2", array_LV_2, false, i+70, false);
+        fRodHolePhysical_2 = new G4PVPlacement(0, G4ThreeVector(x_RodHole, y_RodHole, z_RodHole), fRodHoleLogical_2, "RodHolePhysical_2", array_LV_2, false, i+70, checkOverlaps);
     }
-    G4cout << "Placed physical volume: " << fRodHolePhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodHolePhysical_2->GetName());
 
     // rod
     auto fRodSolid_2 = new G4Tubs("RodTubs_2", 0., kRodDiameter / 2., vShashRodLength / 2., 0, 360);
     fRodLogical_2 = new G4LogicalVolume(fRodSolid_2, steel, "RodLogical_2");
     G4VPhysicalVolume *fRodPhysical_2 = new G4PVPlacement(0, G4ThreeVector(0, 0, 0), fRodLogical_2, "RodPhysical_2", fRodHoleLogical_2, false, 7, checkOverlaps);
-    G4cout << "Placed physical volume: " << fRodPhysical_2->GetName() << G4endl;
+    Logger::Log(Logger::kDebug, "Geometry", "Placed physical volume: " + fRodPhysical_2->GetName());
+
+    // Leakage shell: thin air plates around the sectors (LeakageSD), the
+    // tracks leaving the envelope are scored and killed there
+    // copy number: 0 front, 1 back, 2 +x, 3 -x, 4 +y, 5 -y
+    G4LogicalVolume *fLeakageLogical[3] = {nullptr, nullptr, nullptr};
+    if (fUseLeakageShells) {
+        G4double envelopeZMin = UsePbWO4EMCal ? -100*cm - EmcLVBoxLength/2. : WSciZMin;
+        G4double envelopeZMax = CurrentZPos + PbSciBoxLength/2.;
+        G4double envelopeXY = std::max(vNWSci * vWSciArraySize, vNShash * vShashArraySizeXY) / 2.;
+        if (UsePbWO4EMCal) envelopeXY = std::max(envelopeXY, vNEMc * vEMArraySizeXY / 2.);
+        envelopeXY += kLeakageGap;
+        envelopeZMin -= kLeakageGap;
+        envelopeZMax += kLeakageGap;
+        G4double envelopeZ = (envelopeZMin + envelopeZMax) / 2.;
+        G4double envelopeHalfZ = (envelopeZMax - envelopeZMin) / 2.;
+
+        // the shells must stay inside the fixed world box
+        if (envelopeXY + kLeakageThick > worldSolid->GetXHalfLength()
+            || envelopeXY + kLeakageThick > worldSolid->GetYHalfLength()
+            || envelopeZMin - kLeakageThick < -worldSolid->GetZHalfLength()
+            || envelopeZMax + kLeakageThick > worldSolid->GetZHalfLength()) {
+            G4ExceptionDescription msg;
+            msg << "Leakage shell (half width " << (envelopeXY + kLeakageThick) / cm << " cm, z "
+                << (envelopeZMin - kLeakageThick) / cm << " to " << (envelopeZMax + kLeakageThick) / cm
+                << " cm) outside the world box (" << worldSolid->GetXHalfLength() / cm << " x "
+                << worldSolid->GetYHalfLength() / cm << " x " << worldSolid->GetZHalfLength() / cm
+                << " cm half sizes), fewer modules (/det/WSci/NModule, /det/Shash/NModule) or /det/UseLeakageShells false";
+            G4Exception("DetectorConstruction::Construct()", "MyCode0021", FatalException, msg);
+        }
+
+        auto fLeakageSolid_Z = new G4Box("LeakageBox_Z", envelopeXY + kLeakageThick, envelopeXY + kLeakageThick, kLeakageThick / 2.);
+        auto fLeakageSolid_X = new G4Box("LeakageBox_X", kLeakageThick / 2., envelopeXY + kLeakageThick, envelopeHalfZ);
+        auto fLeakageSolid_Y = new G4Box("LeakageBox_Y", envelopeXY, kLeakageThick / 2., envelopeHalfZ);
+        fLeakageLogical[0] = new G4LogicalVolume(fLeakageSolid_Z, air, "LeakageLogical_Z");
+        fLeakageLogical[1] = new G4LogicalVolume(fLeakageSolid_X, air, "LeakageLogical_X");
+        fLeakageLogical[2] = new G4LogicalVolume(fLeakageSolid_Y, air, "LeakageLogical_Y");
+
+        G4double dXY = envelopeXY + kLeakageThick / 2.;
+        new G4PVPlacement(0, G4ThreeVector(0, 0, envelopeZMin - kLeakageThick / 2.), fLeakageLogical[0], "LeakagePhysical", worldLogical, false, 0, checkOverlaps);
+        new G4PVPlacement(0, G4ThreeVector(0, 0, envelopeZMax + kLeakageThick / 2.), fLeakageLogical[0], "LeakagePhysical", worldLogical, false, 1, checkOverlaps);
+        new G4PVPlacement(0, G4ThreeVector( dXY, 0, envelopeZ), fLeakageLogical[1], "LeakagePhysical", worldLogical, false, 2, checkOverlaps);
+        new G4PVPlacement(0, G4ThreeVector(-dXY, 0, envelopeZ), fLeakageLogical[1], "LeakagePhysical", worldLogical, false, 3, checkOverlaps);
+        new G4PVPlacement(0, G4ThreeVector(0,  dXY, envelopeZ), fLeakageLogical[2], "LeakagePhysical", worldLogical, false, 4, checkOverlaps);
+        new G4PVPlacement(0, G4ThreeVector(0, -dXY, envelopeZ), fLeakageLogical[2], "LeakagePhysical", worldLogical, false, 5, checkOverlaps);
+        Logger::Log(Logger::kDebug, "Geometry",
+                    "Placed leakage shell: z " + std::to_string(envelopeZMin / cm) + " to "
+                        + std::to_string(envelopeZMax / cm) + " cm, half width " + std::to_string(envelopeXY / cm)
+                        + " cm");
+    }
 
 ////////////////////////////
 ////////////////////////////
@@ -671,6 +769,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     auto visAttributes = new G4VisAttributes(G4Colour(0, 0, 0, 0));
     //worldLogical->SetVisAttributes(G4VisAttributes::GetInvisible());
     worldLogical->SetVisAttributes(linegrey);
+    for (auto leakageLogical : fLeakageLogical) {
+        if (leakageLogical) leakageLogical->SetVisAttributes(G4VisAttributes::GetInvisible());
+    }
     
     if (UsePbWO4EMCal) {
         fCoatingLogical_EM->SetVisAttributes(G4VisAttributes::GetInvisible());
@@ -734,11 +835,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     array_LV_WSci->SetVisAttributes(linegrey);
 
     // Scintillator - World
-    G4OpticalSurface *opSurface_ScinAir = new G4OpticalSurface("Surface_ScinAir",     // Surface Name
-            glisur,                           // SetModel, define Setfinish, LUT not installed ???????????
-            polishedair,      // SetFinish (polished or ground) polished improve Nphotons significant
-            dielectric_dielectric, // Set Type
-            polished);                        // vlaue
+    G4OpticalSurface *opSurface_ScinAir = fMaterials->GetScinAirSurface();
 
     new G4LogicalBorderSurface("ScinSurface_0", fWScinPhysical, worldPhysical, opSurface_ScinAir);  //实际没有接触，以防万一
     new G4LogicalBorderSurface("WorldScinSurface_1", worldPhysical, fWScinPhysical, opSurface_ScinAir);
@@ -762,11 +859,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     new G4LogicalBorderSurface("ScinRodHoleSurface_2", fScinPhysical_2, fRodHolePhysical_2, opSurface_ScinAir);
 
         // WLS
-    G4OpticalSurface *opSurface_fiber = new G4OpticalSurface("Surface_fiber",               // Surface Name
-            glisur,                         // SetModel, define Setfinish
-            polished,                       // SetFinish (polished or ground) polished improve Nphotons significan; polishedAir work bad
-            dielectric_dielectric, // SetType
-            polished);                              // vlaue
+    G4OpticalSurface *opSurface_fiber = fMaterials->GetFiberSurface();
 
     // Clad2 - Air(hole)
     new G4LogicalBorderSurface("Clad2AirSurface_0", fClad2Physical_0, fHolePhysical_0, opSurface_fiber);
@@ -803,41 +896,13 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     new G4LogicalSkinSurface("TyvekSurface_2", fReflectorLogical_2, TyvekSurface);
 
     // TiO2: coating
-    G4OpticalSurface *TiO2Surface = new G4OpticalSurface("TiO2Surface",
-            glisur,
-            ground,
-            dielectric_metal,
-            0.1);
-
-    G4MaterialPropertiesTable *TiO2SurfaceProperty = new G4MaterialPropertiesTable();
-
-    G4double p_TiO2[2] = {2.00 * eV, 3.47 * eV};
-    const G4int nbins = 2;
-
-    G4double refl_TiO2[2] = {0.9, 0.9};
-    TiO2SurfaceProperty->AddProperty("REFLECTIVITY", p_TiO2, refl_TiO2, nbins);
-    TiO2Surface->SetMaterialPropertiesTable(TiO2SurfaceProperty);
-
+    G4OpticalSurface *TiO2Surface = fMaterials->GetTiO2Surface();
     new G4LogicalSkinSurface("CoatingSurface_0", fCoatingLogical_0, TiO2Surface);
     new G4LogicalSkinSurface("CoatingSurface_1", fCoatingLogical_1, TiO2Surface); //why add this, the result become non-physical??? seem OK now.
     new G4LogicalSkinSurface("CoatingSurface_2", fCoatingLogical_2, TiO2Surface);
 
     // Mirror
-    G4OpticalSurface *MirrorSurface = new G4OpticalSurface("MirrorSurface",
-            glisur,
-            ground,
-            dielectric_metal,
-            1.);  //测试表明影响不是很大??
-
-    G4MaterialPropertiesTable *MirrorSurfaceProperty = new G4MaterialPropertiesTable();
-
-    G4double p_Mirror[2] = {2.00 * eV, 3.47 * eV};
-    G4double refl_Mirror[2] = {0.9, 0.9};
-    G4double effi_Mirror[2] = {1-refl_Mirror[0], 1-refl_Mirror[1]};
-    MirrorSurfaceProperty->AddProperty("REFLECTIVITY", p_Mirror, refl_Mirror, nbins);
-    MirrorSurfaceProperty->AddProperty("EFFICIENCY", p_Mirror, effi_Mirror, nbins);
-    MirrorSurface->SetMaterialPropertiesTable(MirrorSurfaceProperty);
-
+    G4OpticalSurface *MirrorSurface = fMaterials->GetMirrorSurface();
     new G4LogicalSkinSurface("MirrorSurface_0", fMirrorLogical_0, MirrorSurface);
     new G4LogicalSkinSurface("MirrorSurface_1", fMirrorLogical_1, MirrorSurface);
     new G4LogicalSkinSurface("MirrorSurface_2", fMirrorLogical_2, MirrorSurface);
@@ -849,6 +914,10 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     new G4LogicalSkinSurface("SipmSurface_2", fSipmLogical_2, SipmSurface);
     if (UsePbWO4EMCal) new G4LogicalSkinSurface("PMTSurface", fPMTLogical_EM, SipmSurface);
 
+    // Regions for production cuts and step limits
+    SetupRegions();
+
+    if (!cacheFile.empty()) WriteGDML(worldPhysical, cacheFile);
 
     // return the world physical volume ----------------------------------------
     return worldPhysical;
@@ -859,56 +928,13 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
 void DetectorConstruction::DefineMaterials()
 {
-    // Lead material defined using NIST Manager
-    auto nistManager = G4NistManager::Instance();
-    //  nistManager->FindOrBuildMaterial("G4_Pb");
-
-    // Air
-    nistManager->FindOrBuildMaterial("G4_AIR");
-    // Scintillator
-    nistManager->FindOrBuildMaterial("G4_PLASTIC_SC_VINYLTOLUENE");
-    // Lead
-    nistManager->FindOrBuildMaterial("G4_Pb");
-    // SiO2
-    nistManager->FindOrBuildMaterial("G4_SILICON_DIOXIDE");
-    // Al
-    nistManager->FindOrBuildMaterial("G4_Al");
-    // Si
-    nistManager->FindOrBuildMaterial("G4_Si");
-    // steel
-    nistManager->FindOrBuildMaterial("G4_STAINLESS-STEEL");
-    // PMMA
-    nistManager->FindOrBuildMaterial("PMMA");
-    // Pethylene
-    nistManager->FindOrBuildMaterial("Pethylene");
-    // FPethylene
-    nistManager->FindOrBuildMaterial("FPethylene");
-    // TiO2
-    nistManager->FindOrBuildMaterial("G4_TITANIUM_DIOXIDE");
-    // Tyvek
-    nistManager->FindOrBuildMaterial("Tyvek");
-    // Tungstate
-    nistManager->FindOrBuildMaterial("G4_W");
-    // Iron
-    nistManager->FindOrBuildMaterial("G4_Fe");
-    // PbWO4
-    nistManager->FindOrBuildMaterial("G4_PbWO4");
-    // Cu
-    nistManager->FindOrBuildMaterial("G4_Cu");
-
-    // Liquid argon material
-    G4double a;  // mass of a mole;
-    G4double z;  // z=mean number of protons;  
-    G4double density;
-    new G4Material("liquidArgon", z=18., a= 39.95*g/mole, density= 1.390*g/cm3);
-    // The argon by NIST Manager is a gas with a different density
-
-    // Vacuum
-    new G4Material("Galactic", z=1., a=1.01*g/mole,density= universe_mean_density,
-                   kStateGas, 2.73*kelvin, 3.e-18*pascal);
-
-    // Print materials
-    G4cout << *(G4Material::GetMaterialTable()) << G4endl;
+    // NIST and custom materials and the optical surfaces are built once per
+    // process in ZDCMaterials, a geometry rebuild only looks them up
+    ZDCMaterials::SetVerbose(fVerbose);
+    fMaterials = ZDCMaterials::GetInstance();
+
+    // Print materials, also available with /material/g4/printMaterial all
+    if (fVerbose > 0) G4cout << *(G4Material::GetMaterialTable()) << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -924,6 +950,7 @@ void DetectorConstruction::ConstructSDandField()
     if(!sd_initialized){
         auto absoSD1 = new CalorimeterSD("AbsorberSD1", "AbsorberHitsCollection1");
         G4SDManager::GetSDMpointer()->AddNewDetector(absoSD1);
+        absoSD1->SetFilter(fSDFilters["AbsorberSD1"]);
 
         if (UsePbWO4EMCal)
         SetSensitiveDetector("CrysLogical_EM",  absoSD1);
@@ -940,10 +967,27 @@ void DetectorConstruction::ConstructSDandField()
 
         auto SipmSD2 = new SipmSD("SipmSD2", "SipmHitsCollection2");
         G4SDManager::GetSDMpointer()->AddNewDetector(SipmSD2);
+        SipmSD2->SetFilter(fSDFilters["SipmSD2"]);
         if (UsePbWO4EMCal) SetSensitiveDetector("PMTLogical_EM",SipmSD2); //use string name
         SetSensitiveDetector("SipmLogical_0",   SipmSD2);
         SetSensitiveDetector("SipmLogical_1",   SipmSD2);
         SetSensitiveDetector("SipmLogical_2",   SipmSD2);
+
+        if (fUseLeakageShells) {
+            auto leakageSD = new LeakageSD("LeakageSD");
+            G4SDManager::GetSDMpointer()->AddNewDetector(leakageSD);
+            SetSensitiveDetector("LeakageLogical_Z", leakageSD);
+            SetSensitiveDetector("LeakageLogical_X", leakageSD);
+            SetSensitiveDetector("LeakageLogical_Y", leakageSD);
+        }
+
+        // fast transport of the photons trapped in the fiber cores, per thread
+        if (fUseFastFiberModel && fFastSimulationRegistered) {
+            for (G4String sector : {"WSci", "Shash1", "Shash2"}) {
+                auto region = G4RegionStore::GetInstance()->GetRegion(sector + "_Fiber", false);
+                if (region) new WLSFiberModel("WLSFiberModel_" + sector, region);
+            }
+        }
     
         // 
         // Magnetic field
@@ -997,6 +1041,29 @@ void DetectorConstruction::SetNewValueInt(G4String key, G4int value){
         vNFiberHole_Shash2= value;
         G4cout << "Set NFiberHole value = " << value << G4endl;
     }
+    else if(key == "Verbose"){
+        fVerbose = value;
+        G4cout << "Set Verbose value = " << value << G4endl;
+    }
+    else if(key == "CheckOverlaps"){
+        fCheckOverlaps = value;
+        G4cout << "Set CheckOverlaps value = " << value << G4endl;
+    }
+    else if(key == "UseFastFiberModel"){
+        fUseFastFiberModel = value;
+        if (fUseFastFiberModel) RegisterFastSimulation();
+        G4cout << "Set UseFastFiberModel value = " << value << G4endl;
+    }
+    else if(key == "CalorCellMode"){
+        // read by CalorimeterSD at the next event, no geometry change
+        fCalorCellMode = value;
+        G4cout << "Set CalorCellMode value = " << value << G4endl;
+        return;
+    }
+    else if(key == "UseLeakageShells"){
+        fUseLeakageShells = value;
+        G4cout << "Set UseLeakageShells value = " << value << G4endl;
+    }
     G4RunManager::GetRunManager()->GeometryHasBeenModified(); // 是一个用于标记几何结构已被修改的方法。它是用来通知 Geant4 几何发生了变化，需要在下一个run中重新初始化几何结构。 告知 Geant4 需要更新几何
 }
 
@@ -1037,12 +1104,372 @@ void DetectorConstruction::SetNewValueDouble(G4String key, G4double value){
         vShashSize = value;
         G4cout << "Set vhashSize value = " << value << G4endl;
     }
+    else if(key == "OpticalBinWidth"){
+        ZDCMaterials::SetOpticalBinWidth(value);
+        G4cout << "Set OpticalBinWidth value = " << value << G4endl;
+    }
     G4RunManager::GetRunManager()->GeometryHasBeenModified(); // 是一个用于标记几何结构已被修改的方法。它是用来通知 Geant4 几何发生了变化，需要在下一个run中重新初始化几何结构。 告知 Geant4 需要更新几何
 }
 
 
+void DetectorConstruction::RegisterFastSimulation(){
+    // the fast simulation manager process runs at every optical photon step,
+    // only added for the model; /det/UseFastFiberModel is PreInit only, so
+    // the physics list is not built yet
+    if (fFastSimulationRegistered) return;
+    auto physicsList = dynamic_cast<G4VModularPhysicsList*>(
+        const_cast<G4VUserPhysicsList*>(G4RunManager::GetRunManager()->GetUserPhysicsList()));
+    if (!physicsList) {
+        G4Exception("DetectorConstruction::RegisterFastSimulation()", "MyCode0020", JustWarning,
+                    "No modular physics list, WLSFiberModel is not applied.");
+        return;
+    }
+    auto fastSimulationPhysics = new G4FastSimulationPhysics();
+    fastSimulationPhysics->ActivateFastSimulation("opticalphoton");
+    physicsList->RegisterPhysics(fastSimulationPhysics);
+    fFastSimulationRegistered = true;
+}
+
+void DetectorConstruction::SetOpticalDataDir(const G4String& directory){
+    ZDCMaterials::SetOpticalDataDir(directory);
+    G4cout << "Set OpticalDataDir value = " << directory << G4endl;
+}
+
 void DetectorConstruction::UpdateGeometry() {
     G4RunManager::GetRunManager()->ReinitializeGeometry();
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// the GDML writer appends the address (0x...) to keep the names unique
+G4String StripAddress(const G4String& name)
+{
+    return name.substr(0, name.find("0x"));
+}
+}  // namespace
+
+void DetectorConstruction::SetGeometryCache(const G4String& directory)
+{
+#ifdef ZDC_USE_GDML
+    fGeometryCacheDir = directory == "none" ? "" : directory;
+    G4cout << "Set GeometryCache value = " << directory << G4endl;
+#else
+    G4Exception("DetectorConstruction::SetGeometryCache()", "MyCode0019", JustWarning,
+                "Geant4 is built without GDML, the geometry is not cached.");
+#endif
+}
+
+void DetectorConstruction::ExportGDML(const G4String& fileName) const
+{
+    auto world = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+    if (!world) {
+        G4Exception("DetectorConstruction::ExportGDML()", "MyCode0019", JustWarning, "No geometry built yet.");
+        return;
+    }
+    WriteGDML(world, fileName);
+}
+
+G4String DetectorConstruction::GetGeometryCacheFile() const
+{
+    if (fGeometryCacheDir.empty()) return "";
+
+    // the parameters of Construct() and the version of the code placing the
+    // volumes, same key for every build of the same source
+    Fnv1a h;
+    h.Add(std::string(G4Version));
+    h.Add(kGeometryVersion);
+    for (G4int v : {vNEMc, vNWSci, vNWSciLayer, vNShash, vNShashLayer, vNFiberHole_WSci, vNFiberHole_Shash1,
+                    vNFiberHole_Shash2, G4int(fUseLeakageShells), G4int(UsePbWO4EMCal)})
+        h.Add(v);
+    for (G4double v : {vEMSize, vEMLength, vWSciSize, vWSciWThick, vWSciSciThick, vShashScinThick,
+                       vShashLeadThick, vShashSize})
+        h.Add(v);
+    return fGeometryCacheDir + "/geometry_" + h.Hex() + ".gdml";
+}
+
+G4VPhysicalVolume* DetectorConstruction::ReadGDML(const G4String& fileName)
+{
+#ifdef ZDC_USE_GDML
+    if (!std::filesystem::exists(fileName)) return nullptr;
+
+    // read with the addresses in the names: the GDML materials and optical
+    // surfaces are copies that must not shadow the ZDCMaterials ones
+    G4GDMLParser parser;
+    parser.SetStripFlag(false);
+    parser.Read(fileName, false);
+    auto world = parser.GetWorldVolume();
+    if (!world) {
+        G4ExceptionDescription msg;
+        msg << "Cannot read " << fileName << ", the geometry is rebuilt.";
+        G4Exception("DetectorConstruction::ReadGDML()", "MyCode0019", JustWarning, msg);
+        return nullptr;
+    }
+
+    // the volumes get their names back, the SDs and regions are attached by
+    // name, and the materials of a fresh build
+    for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+        if (volume->GetName().find("0x") == std::string::npos) continue;
+        volume->SetName(StripAddress(volume->GetName()));
+        auto material = G4Material::GetMaterial(StripAddress(volume->GetMaterial()->GetName()), false);
+        if (material) volume->SetMaterial(material);
+    }
+    for (auto volume : *G4PhysicalVolumeStore::GetInstance()) {
+        if (volume->GetName().find("0x") != std::string::npos) volume->SetName(StripAddress(volume->GetName()));
+    }
+
+    // and the optical surfaces of ZDCMaterials
+    auto restore = [](G4LogicalSurface* surface) {
+        if (surface->GetName().find("0x") == std::string::npos) return;
+        surface->SetName(StripAddress(surface->GetName()));
+        const G4String name = StripAddress(surface->GetSurfaceProperty()->GetName());
+        for (auto property : *G4SurfaceProperty::GetSurfacePropertyTable()) {
+            if (property->GetName() == name) {
+                surface->SetSurfaceProperty(property);
+                break;
+            }
+        }
+    };
+    for (const auto& [volume, surface] : *G4LogicalSkinSurface::GetSurfaceTable()) restore(surface);
+    for (const auto& [volumes, surface] : *G4LogicalBorderSurface::GetSurfaceTable()) restore(surface);
+
+    G4cout << "Geometry read from " << fileName << " (no vis attributes)" << G4endl;
+    return world;
+#else
+    return nullptr;
+#endif
+}
+
+void DetectorConstruction::WriteGDML(const G4VPhysicalVolume* world, const G4String& fileName) const
+{
+#ifdef ZDC_USE_GDML
+    // written aside and renamed, concurrent jobs only ever read complete files
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const fs::path path(fileName);
+    if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+    const G4String tmpName = fs::path(path).replace_extension(".tmp" + std::to_string(::getpid()) + ".gdml").string();
+
+    G4GDMLParser parser;
+    parser.SetOutputFileOverwrite(true);
+    parser.Write(tmpName, world, true);
+    fs::rename(tmpName, fileName, ec);
+    if (ec) {
+        G4ExceptionDescription msg;
+        msg << "Cannot write " << fileName << ": " << ec.message();
+        G4Exception("DetectorConstruction::WriteGDML()", "MyCode0019", JustWarning, msg);
+        fs::remove(tmpName, ec);
+        return;
+    }
+    G4cout << "Geometry written to " << fileName << G4endl;
+#else
+    G4ExceptionDescription msg;
+    msg << "Geant4 is built without GDML, " << fileName << " is not written.";
+    G4Exception("DetectorConstruction::WriteGDML()", "MyCode0019", JustWarning, msg);
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// a region setting applies if the key is "all", the region name, its sector
+// (name prefix) or its part (name suffix)
+G4bool RegionMatches(const G4String& region, const G4String& key)
+{
+    if (key == "all" || key == region) return true;
+    auto pos = region.find('_');
+    if (pos == std::string::npos) return false;
+    return region.substr(0, pos) == key || region.substr(pos + 1) == key;
+}
+
+// last matching setting of a region, -1 if none
+G4double RegionSetting(const G4String& region, const std::vector<std::pair<G4String, G4double>>& settings)
+{
+    G4double value = -1.;
+    for (const auto& setting : settings)
+        if (RegionMatches(region, setting.first)) value = setting.second;
+    return value;
+}
+}  // namespace
+
+void DetectorConstruction::SetupRegions()
+{
+    // Absorber: W/lead, plates and support rods; Active: scintillator/crystal;
+    // Optics: thin coating, reflector and fiber holes (claddings, mirror, SiPM);
+    // Fiber: WLS fiber core, envelope of the WLSFiberModel
+    std::vector<std::pair<G4String, std::vector<G4String>>> regionVolumes;
+    if (UsePbWO4EMCal) {
+        regionVolumes.push_back({"Emc_Active",  {"CrysLogical_EM"}});
+        regionVolumes.push_back({"Emc_Optics",  {"CoatingLogical_EM", "PMTLogical_EM"}});
+    }
+    regionVolumes.push_back({"WSci_Absorber",   {"WLogical", "RodHoleLogical_0"}});
+    regionVolumes.push_back({"WSci_Active",     {"WScinLogical"}});
+    regionVolumes.push_back({"WSci_Optics",     {"CoatingLogical_0", "ReflectorLogical_0", "HoleLogical_0"}});
+    regionVolumes.push_back({"WSci_Fiber",      {"WLSLogical_0"}});
+    for (G4String sec : {"1", "2"}) {
+        regionVolumes.push_back({"Shash" + sec + "_Absorber", {"LeadLogical_" + sec, "FrontPlateLogical_" + sec,
+                                                               "BackPlateLogical_" + sec, "RodHoleLogical_" + sec}});
+        regionVolumes.push_back({"Shash" + sec + "_Active",   {"ScinLogical_" + sec}});
+        regionVolumes.push_back({"Shash" + sec + "_Optics",   {"CoatingLogical_" + sec, "ReflectorLogical_" + sec,
+                                                               "HoleLogical_" + sec}});
+        regionVolumes.push_back({"Shash" + sec + "_Fiber",    {"WLSLogical_" + sec}});
+    }
+
+    auto regionStore = G4RegionStore::GetInstance();
+    auto volumeStore = G4LogicalVolumeStore::GetInstance();
+
+    fRegionNames.clear();
+    for (const auto& [name, volumes] : regionVolumes) {
+        auto region = regionStore->FindOrCreateRegion(name);
+
+        // drop the volumes of a previous geometry before a rebuild
+        std::vector<G4LogicalVolume*> oldVolumes(region->GetRootLogicalVolumeIterator(),
+                                                 region->GetRootLogicalVolumeIterator() + region->GetNumberOfRootVolumes());
+        for (auto lv : oldVolumes) region->RemoveRootLogicalVolume(lv);
+
+        // the latest volume with this name, older ones are left over from rebuilds
+        for (const auto& volume : volumes) {
+            auto lv = volumeStore->GetVolume(volume, false, true);
+            if (!lv) {
+                G4ExceptionDescription msg;
+                msg << "Logical volume " << volume << " not found for region " << name;
+                G4Exception("DetectorConstruction::SetupRegions()", "MyCode0010", JustWarning, msg);
+                continue;
+            }
+            region->AddRootLogicalVolume(lv);
+        }
+        fRegionNames.push_back(name);
+    }
+
+    ApplyRegionSettings();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::ApplyRegionSettings()
+{
+    auto defaultCuts = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+
+    for (const auto& name : fRegionNames) {
+        auto region = G4RegionStore::GetInstance()->GetRegion(name, false);
+        if (!region) continue;
+
+        G4double cut = RegionSetting(name, fRegionCuts);
+        G4double maxStep = RegionSetting(name, fRegionMaxSteps);
+
+        // without a setting the region follows the world cuts (/run/setCut)
+        if (cut > 0.) {
+            if (!region->GetProductionCuts() || region->GetProductionCuts() == defaultCuts)
+                region->SetProductionCuts(new G4ProductionCuts());
+            region->GetProductionCuts()->SetProductionCut(cut);
+        }
+        else if (!region->GetProductionCuts()) {
+            region->SetProductionCuts(defaultCuts);
+        }
+
+        // needs G4StepLimiterPhysics in the physics list
+        if (maxStep > 0.) {
+            if (!region->GetUserLimits())
+                region->SetUserLimits(new G4UserLimits(maxStep));
+            else
+                region->GetUserLimits()->SetMaxAllowedStep(maxStep);
+        }
+    }
+
+    // kill thresholds, also in the world region with "all"
+    std::vector<G4String> killRegions = fRegionNames;
+    killRegions.push_back("DefaultRegionForTheWorld");
+    for (const auto& name : killRegions) {
+        auto region = G4RegionStore::GetInstance()->GetRegion(name, false);
+        if (!region) continue;
+
+        auto info = static_cast<RegionInformation*>(region->GetUserInformation());
+        if (!info) info = new RegionInformation();
+        info->SetTimeCut(RegionSetting(name, fRegionTimeCuts));
+        info->SetEnergyCut(RegionSetting(name, fRegionEnergyCuts));
+        info->SetNeutronTimeCut(RegionSetting(name, fRegionNeutronTimeCuts));
+        info->SetNeutronEnergyCut(RegionSetting(name, fRegionNeutronEnergyCuts));
+
+        // regions without cuts keep no information, SteppingAction skips them
+        if (info->HasCuts()) {
+            region->SetUserInformation(info);
+        }
+        else {
+            region->SetUserInformation(nullptr);
+            delete info;
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetRegionCut(const G4String& key, G4double cut)
+{
+    fRegionCuts.push_back({key, cut});
+    G4cout << "Set region cut " << key << " value = " << cut / mm << " mm" << G4endl;
+
+    // regions exist once the geometry is built, otherwise applied in Construct()
+    ApplyRegionSettings();
+    if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+        G4UImanager::GetUIpointer()->ApplyCommand("/run/physicsModified");
+}
+
+void DetectorConstruction::SetRegionMaxStep(const G4String& key, G4double step)
+{
+    fRegionMaxSteps.push_back({key, step});
+    G4cout << "Set region max step " << key << " value = " << step / mm << " mm" << G4endl;
+    ApplyRegionSettings();
+}
+
+void DetectorConstruction::SetRegionKillCut(const G4String& cut, const G4String& key, G4double value)
+{
+    if (cut == "TimeCut") fRegionTimeCuts.push_back({key, value});
+    else if (cut == "EnergyCut") fRegionEnergyCuts.push_back({key, value});
+    else if (cut == "NeutronTimeCut") fRegionNeutronTimeCuts.push_back({key, value});
+    else if (cut == "NeutronEnergyCut") fRegionNeutronEnergyCuts.push_back({key, value});
+    else return;
+    G4cout << "Set region " << cut << " " << key << " value = " << value << G4endl;
+    ApplyRegionSettings();
+}
+
+std::vector<SDFilter*> DetectorConstruction::GetSDFilters(const G4String& key) const
+{
+    std::vector<SDFilter*> filters;
+    for (const auto& [sd, filter] : fSDFilters)
+        if (key == "all" || key == sd) filters.push_back(filter);
+    if (filters.empty()) {
+        G4ExceptionDescription msg;
+        msg << "No sensitive detector " << key << " with a filter (AbsorberSD1, SipmSD2 or all).";
+        G4Exception("DetectorConstruction::GetSDFilters()", "MyCode0016", JustWarning, msg);
+    }
+    return filters;
+}
+
+void DetectorConstruction::PrintSDFilters() const
+{
+    G4cout << "---------------------SD filters---------------------" << G4endl;
+    for (const auto& [sd, filter] : fSDFilters) filter->Print();
+}
+
+void DetectorConstruction::PrintRegions() const
+{
+    G4cout << "---------------------Regions---------------------" << G4endl;
+    for (const auto& name : fRegionNames) {
+        auto region = G4RegionStore::GetInstance()->GetRegion(name, false);
+        if (!region) continue;
+        auto cuts = region->GetProductionCuts();
+        G4double maxStep = RegionSetting(name, fRegionMaxSteps);
+        G4cout << std::setw(16) << name << " volumes: " << region->GetNumberOfRootVolumes();
+        if (cuts)
+            G4cout << "  cut gamma/e-/e+/p: " << cuts->GetProductionCut("gamma") / mm << "/"
+                   << cuts->GetProductionCut("e-") / mm << "/" << cuts->GetProductionCut("e+") / mm << "/"
+                   << cuts->GetProductionCut("proton") / mm << " mm";
+        if (maxStep > 0.) G4cout << "  max step: " << maxStep / mm << " mm";
+        if (region->GetUserInformation()) region->GetUserInformation()->Print();
+        G4cout << G4endl;
+    }
+}
+
 }  // namespace ZDC
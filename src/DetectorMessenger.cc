@@ -1,13 +1,18 @@
 #include "DetectorMessenger.hh"
 
 #include "DetectorConstruction.hh"
+#include "SDFilter.hh"
 
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithADouble.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithALongInt.hh"
 #include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithABool.hh"
 #include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
 
 
 namespace ZDC
@@ -23,6 +28,51 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det) : fDetectorConst
   fInitGeo = new G4UIcmdWithoutParameter("/det/InitGeo", this);
   fInitGeo->AvailableForStates(G4State_PreInit, G4State_Idle); 
 
+  fCheckOverlaps = new G4UIcmdWithABool("/det/CheckOverlaps", this);
+  fCheckOverlaps->SetGuidance("Check overlaps of each placement while building the geometry.");
+  fCheckOverlaps->SetGuidance("Slow for large geometries, zdc_check_geometry checks in parallel.");
+  fCheckOverlaps->SetDefaultValue(true);
+  fCheckOverlaps->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fUseFastFiberModel = new G4UIcmdWithABool("/det/UseFastFiberModel", this);
+  fUseFastFiberModel->SetGuidance("Transport the optical photons trapped in the WLS fiber cores analytically");
+  fUseFastFiberModel->SetGuidance("(WLSFiberModel) instead of tracking them bounce by bounce.");
+  fUseFastFiberModel->SetDefaultValue(true);
+  fUseFastFiberModel->AvailableForStates(G4State_PreInit);
+
+  fUseLeakageShells = new G4UIcmdWithABool("/det/UseLeakageShells", this);
+  fUseLeakageShells->SetGuidance("Thin shells around the sectors that score the escaping energy per face and");
+  fUseLeakageShells->SetGuidance("particle class (Leak.E) and kill the tracks there (default true).");
+  fUseLeakageShells->SetDefaultValue(true);
+  fUseLeakageShells->AvailableForStates(G4State_PreInit);
+
+  fVerbose = new G4UIcmdWithALongInt("/det/Verbose", this);
+  fVerbose->SetGuidance("Material printout when the geometry is first built:");
+  fVerbose->SetGuidance("0 quiet, 1 material table and NIST manager, 2 also optical property tables.");
+  fVerbose->AvailableForStates(G4State_PreInit);
+
+  fOpticalDataDir = new G4UIcmdWithAString("/det/OpticalDataDir", this);
+  fOpticalDataDir->SetGuidance("Directory with the optical property files, one <name>.dat");
+  fOpticalDataDir->SetGuidance("per material or surface (default data/optics/v1).");
+  fOpticalDataDir->AvailableForStates(G4State_PreInit);
+
+  fOpticalBinWidth = new G4UIcmdWithADoubleAndUnit("/det/OpticalBinWidth", this);
+  fOpticalBinWidth->SetGuidance("Energy bin width of the uniform grid the optical spectra are resampled on.");
+  fOpticalBinWidth->SetGuidance("0 keeps the points of the data files.");
+  fOpticalBinWidth->SetDefaultUnit("eV");
+  fOpticalBinWidth->AvailableForStates(G4State_PreInit);
+
+  fGeometryCache = new G4UIcmdWithAString("/det/GeometryCache", this);
+  fGeometryCache->SetGuidance("Directory of the GDML geometry cache, none (default) disables it.");
+  fGeometryCache->SetGuidance("A built geometry is written to <dir>/geometry_<key>.gdml, the key hashing");
+  fGeometryCache->SetGuidance("the geometry parameters; a later build with the same key reads it instead.");
+  fGeometryCache->SetGuidance("The vis attributes are not cached. Needs Geant4 built with GDML.");
+  fGeometryCache->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fExportGDML = new G4UIcmdWithAString("/det/ExportGDML", this);
+  fExportGDML->SetGuidance("Write the built geometry to a GDML file. Needs Geant4 built with GDML.");
+  fExportGDML->AvailableForStates(G4State_Idle);
+
   // Emc
   vNEmc = new G4UIcmdWithALongInt("/det/Emc/NModule", this);
   vNEmc->AvailableForStates(G4State_PreInit, G4State_Idle);  //could work when "before detector Init + run process idel"
@@ -74,6 +124,98 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det) : fDetectorConst
 
   vNFiberHole_Shash2 = new G4UIcmdWithALongInt("/det/NFiberHole_Shash2", this);
   vNFiberHole_Shash2->AvailableForStates(G4State_PreInit, G4State_Idle); 
+
+  // SD step filters, checked before a hit is made
+  fSDDirectory = new G4UIdirectory("/det/SD/");
+  fSDDirectory->SetGuidance("Step filters of the sensitive detectors AbsorberSD1 and SipmSD2 (or all)");
+
+  fSDTimeWindow = new G4UIcommand("/det/SD/TimeWindow", this);
+  fSDTimeWindow->SetGuidance("Keep the steps starting within [tmin, tmax] global time, tmax <= tmin opens it.");
+  fSDTimeWindow->SetParameter(new G4UIparameter("sd", 's', false));
+  fSDTimeWindow->SetParameter(new G4UIparameter("tmin", 'd', false));
+  fSDTimeWindow->SetParameter(new G4UIparameter("tmax", 'd', false));
+  auto timeUnit = new G4UIparameter("unit", 's', true);
+  timeUnit->SetDefaultUnit("ns");
+  fSDTimeWindow->SetParameter(timeUnit);
+  fSDTimeWindow->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSDEnergyFloor = new G4UIcommand("/det/SD/EnergyFloor", this);
+  fSDEnergyFloor->SetGuidance("Drop the steps depositing less than this energy, 0 keeps all.");
+  fSDEnergyFloor->SetGuidance("Only cuts AbsorberSD1: the optical photon steps (SipmSD2) deposit nothing");
+  fSDEnergyFloor->SetGuidance("and are always kept. TimeWindow and Particles apply to both SDs.");
+  fSDEnergyFloor->SetParameter(new G4UIparameter("sd", 's', false));
+  fSDEnergyFloor->SetParameter(new G4UIparameter("edep", 'd', false));
+  auto edepUnit = new G4UIparameter("unit", 's', true);
+  edepUnit->SetDefaultUnit("keV");
+  fSDEnergyFloor->SetParameter(edepUnit);
+  fSDEnergyFloor->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSDParticles = new G4UIcommand("/det/SD/Particles", this);
+  fSDParticles->SetGuidance("Accept only these particles (as G4SDParticleFilter), all clears the list.");
+  fSDParticles->SetParameter(new G4UIparameter("sd", 's', false));
+  fSDParticles->SetParameter(new G4UIparameter("particles", 's', false));
+  fSDParticles->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSDCellMode = new G4UIcmdWithABool("/det/SD/CellMode", this);
+  fSDCellMode->SetGuidance("AbsorberSD1 sums the edep and first time per (module, layer) cell (default true);");
+  fSDCellMode->SetGuidance("false makes one hit per track and cell, for debugging.");
+  fSDCellMode->SetDefaultValue(true);
+  fSDCellMode->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSDList = new G4UIcmdWithoutParameter("/det/SD/List", this);
+  fSDList->SetGuidance("Print the SD filters.");
+  fSDList->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // Regions: <sector>_Absorber, <sector>_Active, <sector>_Optics, <sector>_Fiber
+  fRegionDirectory = new G4UIdirectory("/det/Region/");
+  fRegionDirectory->SetGuidance("Production cuts and step limits of the detector regions");
+
+  fRegionCut = new G4UIcommand("/det/Region/SetCut", this);
+  fRegionCut->SetGuidance("Set the production cut of gamma, e-, e+ and proton in regions.");
+  fRegionCut->SetGuidance("  region: region name (e.g. WSci_Optics), sector (Emc, WSci, Shash1, Shash2),");
+  fRegionCut->SetGuidance("          part (Absorber, Active, Optics, Fiber) or all");
+  fRegionCut->SetParameter(new G4UIparameter("region", 's', false));
+  auto cutValue = new G4UIparameter("cut", 'd', false);
+  cutValue->SetParameterRange("cut>0.");
+  fRegionCut->SetParameter(cutValue);
+  auto cutUnit = new G4UIparameter("unit", 's', true);
+  cutUnit->SetDefaultUnit("mm");
+  fRegionCut->SetParameter(cutUnit);
+  fRegionCut->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fRegionMaxStep = new G4UIcommand("/det/Region/SetMaxStep", this);
+  fRegionMaxStep->SetGuidance("Set the maximum step length in regions (G4StepLimiter).");
+  fRegionMaxStep->SetGuidance("  region: same as /det/Region/SetCut");
+  fRegionMaxStep->SetParameter(new G4UIparameter("region", 's', false));
+  auto stepValue = new G4UIparameter("step", 'd', false);
+  stepValue->SetParameterRange("step>0.");
+  fRegionMaxStep->SetParameter(stepValue);
+  auto stepUnit = new G4UIparameter("unit", 's', true);
+  stepUnit->SetDefaultUnit("mm");
+  fRegionMaxStep->SetParameter(stepUnit);
+  fRegionMaxStep->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // track kill thresholds, applied in SteppingAction
+  const char* killCuts[4][3] = {{"TimeCut", "Kill the tracks later than this global time", "ns"},
+                                {"EnergyCut", "Kill the tracks below this kinetic energy (not optical photons)", "MeV"},
+                                {"NeutronTimeCut", "Kill the neutrons later than this global time", "ns"},
+                                {"NeutronEnergyCut", "Kill the neutrons below this kinetic energy", "MeV"}};
+  for (G4int i = 0; i < 4; i++) {
+    fRegionKillCut[i] = new G4UIcommand(G4String("/det/Region/Set") + killCuts[i][0], this);
+    fRegionKillCut[i]->SetGuidance(G4String(killCuts[i][1]) + " in regions, their energy goes to E.Cut.");
+    fRegionKillCut[i]->SetGuidance("  region: same as /det/Region/SetCut, all also covers the world air");
+    fRegionKillCut[i]->SetGuidance("  a negative value removes the cut; neutron cuts replace the others for neutrons");
+    fRegionKillCut[i]->SetParameter(new G4UIparameter("region", 's', false));
+    fRegionKillCut[i]->SetParameter(new G4UIparameter("value", 'd', false));
+    auto killUnit = new G4UIparameter("unit", 's', true);
+    killUnit->SetDefaultUnit(killCuts[i][2]);
+    fRegionKillCut[i]->SetParameter(killUnit);
+    fRegionKillCut[i]->AvailableForStates(G4State_PreInit, G4State_Idle);
+  }
+
+  fRegionList = new G4UIcmdWithoutParameter("/det/Region/List", this);
+  fRegionList->SetGuidance("Print the regions with their cuts and step limits.");
+  fRegionList->AvailableForStates(G4State_Idle);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -89,6 +231,30 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   if (command == fInitGeo) {
     fDetectorConstruction->UpdateGeometry();
   }
+  else if (command == fVerbose) {
+    fDetectorConstruction->SetNewValueInt("Verbose", fVerbose->GetNewLongIntValue(newValue));
+  }
+  else if (command == fOpticalDataDir) {
+    fDetectorConstruction->SetOpticalDataDir(newValue);
+  }
+  else if (command == fGeometryCache) {
+    fDetectorConstruction->SetGeometryCache(newValue);
+  }
+  else if (command == fExportGDML) {
+    fDetectorConstruction->ExportGDML(newValue);
+  }
+  else if (command == fOpticalBinWidth) {
+    fDetectorConstruction->SetNewValueDouble("OpticalBinWidth", fOpticalBinWidth->GetNewDoubleValue(newValue));
+  }
+  else if (command == fUseLeakageShells) {
+    fDetectorConstruction->SetNewValueInt("UseLeakageShells", fUseLeakageShells->GetNewBoolValue(newValue));
+  }
+  else if (command == fUseFastFiberModel) {
+    fDetectorConstruction->SetNewValueInt("UseFastFiberModel", fUseFastFiberModel->GetNewBoolValue(newValue));
+  }
+  else if (command == fCheckOverlaps) {
+    fDetectorConstruction->SetNewValueInt("CheckOverlaps", fCheckOverlaps->GetNewBoolValue(newValue));
+  }
 
   //Emc
   else if (command == vNEmc) {
@@ -146,6 +312,72 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
     fDetectorConstruction->SetNewValueInt("NFiberHole_Shash2", vNFiberHole_Shash2->GetNewLongIntValue(newValue));
   }
 
+  //Regions
+  else if (command == fRegionCut || command == fRegionMaxStep) {
+    G4String region, unit;
+    G4double value;
+    std::istringstream is(newValue);
+    is >> region >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    if (command == fRegionCut)
+      fDetectorConstruction->SetRegionCut(region, value);
+    else
+      fDetectorConstruction->SetRegionMaxStep(region, value);
+  }
+  else if (command == fRegionKillCut[0] || command == fRegionKillCut[1] || command == fRegionKillCut[2]
+           || command == fRegionKillCut[3]) {
+    G4String region, unit;
+    G4double value;
+    std::istringstream is(newValue);
+    is >> region >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    // command name without "Set"
+    fDetectorConstruction->SetRegionKillCut(command->GetCommandName().substr(3), region, value);
+  }
+  //SD filters
+  else if (command == fSDTimeWindow) {
+    G4String sd, unit;
+    G4double tmin, tmax;
+    std::istringstream is(newValue);
+    is >> sd >> tmin >> tmax >> unit;
+    for (auto filter : fDetectorConstruction->GetSDFilters(sd))
+      filter->SetTimeWindow(tmin * G4UIcommand::ValueOf(unit), tmax * G4UIcommand::ValueOf(unit));
+  }
+  else if (command == fSDEnergyFloor) {
+    G4String sd, unit;
+    G4double value;
+    std::istringstream is(newValue);
+    is >> sd >> value >> unit;
+    for (auto filter : fDetectorConstruction->GetSDFilters(sd))
+      filter->SetEnergyFloor(value * G4UIcommand::ValueOf(unit));
+  }
+  else if (command == fSDParticles) {
+    // the last string parameter takes the rest of the line
+    G4String sd, particle;
+    std::istringstream is(newValue);
+    is >> sd;
+    auto filters = fDetectorConstruction->GetSDFilters(sd);
+    while (is >> particle) {
+      for (auto filter : filters) {
+        if (!filter->AddParticle(particle)) {
+          G4ExceptionDescription msg;
+          msg << "Unknown particle " << particle << " for the SD filter.";
+          G4Exception("DetectorMessenger::SetNewValue()", "MyCode0016", JustWarning, msg);
+          break;
+        }
+      }
+    }
+  }
+  else if (command == fSDCellMode) {
+    fDetectorConstruction->SetNewValueInt("CalorCellMode", fSDCellMode->GetNewBoolValue(newValue));
+  }
+  else if (command == fSDList) {
+    fDetectorConstruction->PrintSDFilters();
+  }
+  else if (command == fRegionList) {
+    fDetectorConstruction->PrintRegions();
+  }
+
 
   // if (command == fDoubleInput) {
   //   fDetectorConstruction->SetDetectorValue(fDoubleInput->GetNewDoubleValue(newValue));
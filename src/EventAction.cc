@@ -4,11 +4,18 @@
 #include "CalorHit.hh"
 #include "SiPMSD.hh"
 #include "SiPMHit.hh"
+#include "LeakageSD.hh"
 #include "Constants.hh"
+#include "DetectorConstruction.hh"
+#include "DetectorID.hh"
+#include "CheckpointManager.hh"
+#include "Logger.hh"
 
 #include "G4AnalysisManager.hh"
 #include "G4Event.hh"
 #include "G4HCofThisEvent.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
 #include "G4RunManager.hh"
 #include "G4SDManager.hh"
 #include "G4UnitsTable.hh"
@@ -98,8 +105,30 @@ void EventAction::BeginOfEventAction(const G4Event * /*event*/){
         ModNPE[i].resize(ArrSize[i], 0);
     }
 
+    //per-(module, layer) edep, sized from the current geometry
+    auto detector = static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    for (int i=0; i<NSector; i++){
+        CellEdepSen[i].clear();
+        CellEdepAbs[i].clear();
+        CellTime[i].clear();
+        fCellNLayer[i] = 0;
+        if (!fCellEdep) continue;
+
+        fCellNLayer[i] = detector->GetNLayer(i);
+        G4int nCell = detector->GetNModule(i) * detector->GetNModule(i) * fCellNLayer[i];
+        CellEdepSen[i].resize(nCell, 0.);
+        CellEdepAbs[i].resize(nCell, 0.);
+        CellTime[i].resize(nCell, -1.);
+    }
+
     SipmID.clear();
+    SipmNPE.clear();
+    SipmAmp.clear();
+    SipmCharge.clear();
     SipmTime.clear();
+    SipmHitID.clear();
+    SipmHitTime.clear();
+    fSipmPhotons.clear();
 
     detectorID.clear();
     particlePDG.clear();
@@ -124,6 +153,7 @@ void EventAction::BeginOfEventAction(const G4Event * /*event*/){
     fEPi0 = 0;
     fEscapeKine = 0;
     fEscapeKineAndNonBaryonMass = 0;
+    fECut = 0;
   }
 
   //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -139,7 +169,33 @@ void EventAction::EndOfEventAction(const G4Event *event)
         fSipmHCID = G4SDManager::GetSDMpointer()->GetCollectionID("SipmHitsCollection2");
     }
 
-    fEventID = event->GetEventID();
+    // counted over the parts of a checkpointed run
+    auto checkpoint = CheckpointManager::Instance();
+    fEventID = event->GetEventID() + (checkpoint ? checkpoint->GetEventOffset() : 0);
+
+    // true primary energy and particle, e.g. for energy scans in one run
+    fGenEnergy = 0.;
+    fGenPDG = 0;
+    for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); i++){
+        for (auto primary = event->GetPrimaryVertex(i)->GetPrimary(); primary; primary = primary->GetNext()){
+            if (fGenPDG == 0) fGenPDG = primary->GetPDGcode();
+            fGenEnergy += primary->GetKineticEnergy();
+        }
+    }
+
+    // energy leaving the sectors, scored and killed on the leakage shell
+    LeakE.clear();
+    // looked up once, absent with /det/UseLeakageShells false
+    if (!fLeakageSDChecked){
+        fLeakageSD = static_cast<LeakageSD*>(G4SDManager::GetSDMpointer()->FindSensitiveDetector("LeakageSD", false));
+        fLeakageSDChecked = true;
+    }
+    if (fLeakageSD){
+        LeakE.assign(fLeakageSD->GetEnergy().begin(), fLeakageSD->GetEnergy().end());
+        fEscapeKine += fLeakageSD->GetKineticEnergy();
+        fEscapeKineAndNonBaryonMass += fLeakageSD->GetKineticEnergy() + fLeakageSD->GetNonBaryonMass();
+    }
+
     // Get hits collections
     auto absoHC = GetHitsCollection(fAbsHCID, event);
     auto SipmHC = GetHitsCollection2(fSipmHCID, event);
@@ -147,22 +203,41 @@ void EventAction::EndOfEventAction(const G4Event *event)
     // Get hit with total values
     //auto absoHit = (*absoHC)[absoHC->entries() - 1];
 
-    // Print per event (modulo n)
+    // Print per event (modulo n, /run/printProgress)
     auto eventID = event->GetEventID();
     auto printModulo = G4RunManager::GetRunManager()->GetPrintProgress();
-    //  if ((printModulo > 0) && (eventID % printModulo == 0)) {
-    //    PrintEventStatistics(absoHit->GetEdep(), absoHit->GetTrackLength(), gapHit->GetEdep(),
-    //                         gapHit->GetTrackLength());
-    G4cout << "--> End of event: " << eventID << "\n"
-           << G4endl;
+    if ((printModulo > 0) && (eventID % printModulo == 0)) {
+        Logger::Log(Logger::kInfo, "Event", "--> End of event: " + std::to_string(eventID));
+    }
 
     // get analysis manager
     auto analysisManager = G4AnalysisManager::Instance();
+
+    // cell mode: sums per (module, layer) from the SD, the hits collection is empty
+    if (!fCalorSD){
+        fCalorSD = static_cast<CalorimeterSD*>(G4SDManager::GetSDMpointer()->FindSensitiveDetector("AbsorberSD1", false));
+    }
+    if (fCalorSD && fCalorSD->IsCellMode()) FillFromCells(fCalorSD);
+
     for (G4int i = absoHC->entries() - 1; i >= 0; i--){
         CalorHit *aHit = (*absoHC)[i];
 
         if (aHit->GetEdep() < 0.0001) continue;
 
+        if (fCellEdep){
+            //sector, module and layer from the digits of the detector ID
+            const DetInfo id = DecodeDetectorID(aHit->GetDetectorID());
+            if (id.sector >= 0 && id.sector < NSector && id.module >= 0 && id.layer < fCellNLayer[id.sector]){
+                const size_t cell = id.module * fCellNLayer[id.sector] + id.layer;
+                if (id.type == kSensitiveType && cell < CellEdepSen[id.sector].size()){
+                    CellEdepSen[id.sector][cell] += aHit->GetEdep();
+                    if (CellTime[id.sector][cell] < 0. || aHit->GetTime() < CellTime[id.sector][cell])
+                        CellTime[id.sector][cell] = aHit->GetTime();
+                }
+                else if (id.type == kAbsorberType && cell < CellEdepAbs[id.sector].size())
+                    CellEdepAbs[id.sector][cell] += aHit->GetEdep();
+            }
+        }
         
         if (aHit->GetPhysVolName() == "LeadPhysical_1"){
             fSecEdepTotAbs[0] += aHit->GetEdep();
@@ -226,8 +301,11 @@ void EventAction::EndOfEventAction(const G4Event *event)
         G4int ID = aHit->GetSipmID();
         G4int IDmodule = (ID /10000) %100 -1;
 
-        SipmID.push_back(ID);
-        SipmTime.push_back(aHit->GetHitTime());
+        fSipmPhotons.emplace_back(ID, aHit->GetHitTime());
+        if (fSipmRawHits){
+            SipmHitID.push_back(ID);
+            SipmHitTime.push_back(aHit->GetHitTime());
+        }
 
         if(ID >= 4000000){  //Emc
             fNPEEmcTot++;
@@ -247,12 +325,39 @@ void EventAction::EndOfEventAction(const G4Event *event)
         }
     }
 
+    // pile-up library of the signal response, then the background responses
+    if (fPileup.IsRecording()) RecordPileup();
+    OverlayPileup();
+
+    // SiPM response, one entry per SiPM above threshold
+    fSipmDigitizer.Digitize(fSipmPhotons, fSipmDigis);
+    for (const auto& digi : fSipmDigis){
+        SipmID.push_back(digi.id);
+        SipmNPE.push_back(digi.npe);
+        SipmAmp.push_back(digi.amplitude);
+        SipmCharge.push_back(digi.charge);
+        SipmTime.push_back(digi.time);
+    }
+
+    // run statistics of the sensitive edep, merged and printed in RunAction
+    G4double sumEdepSen = 0.;
+    for (int i=0; i<NSector; i++){
+        fRunEdepSen[i] += fSecEdepTotSen[i];
+        fRunEdepSen2[i] += fSecEdepTotSen[i] * fSecEdepTotSen[i];
+        sumEdepSen += fSecEdepTotSen[i];
+    }
+    fRunEdepSen[NSector] += sumEdepSen;
+    fRunEdepSen2[NSector] += sumEdepSen * sumEdepSen;
+
+    FillSparseModules();
+
     // fill ntuple
     G4int BranchIdx = 0;
     analysisManager->FillNtupleIColumn(BranchIdx++, fEventID);
     analysisManager->FillNtupleDColumn(BranchIdx++, fEPi0);
     analysisManager->FillNtupleDColumn(BranchIdx++, fEscapeKine);
     analysisManager->FillNtupleDColumn(BranchIdx++, fEscapeKineAndNonBaryonMass);
+    analysisManager->FillNtupleDColumn(BranchIdx++, fECut);
 
     if (UsePbWO4EMCal) analysisManager->FillNtupleDColumn(BranchIdx++, fPbWO4TotalEdep);
     analysisManager->FillNtupleDColumn(BranchIdx++, fSecEdepTotSen[2]);
@@ -266,12 +371,143 @@ void EventAction::EndOfEventAction(const G4Event *event)
     analysisManager->FillNtupleIColumn(BranchIdx++, fSecNEP[2]);
     analysisManager->FillNtupleIColumn(BranchIdx++, fSecNEP[1]);
     analysisManager->FillNtupleIColumn(BranchIdx++, fSecNEP[0]);
+    analysisManager->FillNtupleIColumn(BranchIdx++, fPileupN);
+    analysisManager->FillNtupleDColumn(BranchIdx++, fGenEnergy);
+    analysisManager->FillNtupleIColumn(BranchIdx++, fGenPDG);
+    const G4int nModule[NSector] = {fNShash * fNShash, fNShash * fNShash, fNWSci * fNWSci};
+    for (G4int i = 0; i < NSector; i++) analysisManager->FillNtupleIColumn(BranchIdx++, nModule[i]);
+    for (G4int i = 0; i < NSector; i++) analysisManager->FillNtupleIColumn(BranchIdx++, fCellNLayer[i]);
     
     analysisManager->AddNtupleRow();
   }
 
   //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void EventAction::FillSparseModules()
+{
+    SpEmcIdx.clear();
+    SpEEmcModule.clear();
+    SpNPEEmcModule.clear();
+    for (int i=0; i<NSector; i++){
+        SpModIdx[i].clear();
+        SpModEdepSen[i].clear();
+        SpModEdepAbs[i].clear();
+        SpModNPE[i].clear();
+    }
+    if (!fSparseModules) return;
+
+    // keep only the modules above threshold, the dense vectors are then written empty
+    if (UsePbWO4EMCal){
+        for (size_t j=0; j<EEmcModule.size(); j++){
+            if (EEmcModule[j] > fZeroSuppression || NPEEmcModule[j] > 0){
+                SpEmcIdx.push_back(G4int(j));
+                SpEEmcModule.push_back(EEmcModule[j]);
+                SpNPEEmcModule.push_back(NPEEmcModule[j]);
+            }
+        }
+        EEmcModule.clear();
+        NPEEmcModule.clear();
+    }
+
+    for (int i=0; i<NSector; i++){
+        for (size_t j=0; j<ModEdepSen[i].size(); j++){
+            if (ModEdepSen[i][j] > fZeroSuppression || ModEdepAbs[i][j] > fZeroSuppression || ModNPE[i][j] > 0){
+                SpModIdx[i].push_back(G4int(j));
+                SpModEdepSen[i].push_back(ModEdepSen[i][j]);
+                SpModEdepAbs[i].push_back(ModEdepAbs[i][j]);
+                SpModNPE[i].push_back(ModNPE[i][j]);
+            }
+        }
+        ModEdepSen[i].clear();
+        ModEdepAbs[i].clear();
+        ModNPE[i].clear();
+    }
+}
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::FillFromCells(const CalorimeterSD* sd)
+{
+    for (int i=0; i<NSector; i++){
+        const auto& edepSen = sd->GetCellEdepSen(i);
+        const auto& edepAbs = sd->GetCellEdepAbs(i);
+        const G4int nLayer = sd->GetCellNLayer(i);
+        for (size_t cell=0; cell<edepSen.size(); cell++){
+            if (edepSen[cell] == 0. && edepAbs[cell] == 0.) continue;
+            const size_t module = cell / nLayer;
+            if (module >= ModEdepSen[i].size()) continue;
+            ModEdepSen[i][module] += edepSen[cell];
+            ModEdepAbs[i][module] += edepAbs[cell];
+            fSecEdepTotSen[i] += edepSen[cell];
+            fSecEdepTotAbs[i] += edepAbs[cell];
+        }
+
+        // same geometry, so the same sizes
+        if (fCellEdep && CellEdepSen[i].size() == edepSen.size()){
+            CellEdepSen[i] = edepSen;
+            CellEdepAbs[i] = edepAbs;
+            CellTime[i] = sd->GetCellTime(i);
+        }
+    }
+
+    // EMC, one layer
+    const auto& edepEmc = sd->GetCellEdepSen(NSector);
+    for (size_t module=0; module<edepEmc.size() && module<EEmcModule.size(); module++){
+        EEmcModule[module] += edepEmc[module];
+        fPbWO4TotalEdep += edepEmc[module];
+    }
+}
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::RecordPileup()
+{
+    PileupEvent response;
+    for (int i=0; i<NSector; i++){
+        for (size_t j=0; j<ModEdepSen[i].size(); j++){
+            if (ModEdepSen[i][j] > 0. || ModEdepAbs[i][j] > 0.)
+                response.deposits.push_back({i, G4int(j), G4float(ModEdepSen[i][j]), G4float(ModEdepAbs[i][j])});
+        }
+    }
+    for (size_t j=0; j<EEmcModule.size(); j++){
+        if (EEmcModule[j] > 0.) response.deposits.push_back({NSector, G4int(j), G4float(EEmcModule[j]), 0.f});
+    }
+    for (const auto& photon : fSipmPhotons) response.photons.emplace_back(photon.first, G4float(photon.second));
+    fPileup.Record(response);
+}
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::OverlayPileup()
+{
+    fPileup.Draw(fPileupEvents);
+    fPileupN = fPileupEvents.size();
+
+    for (const auto& background : fPileupEvents){
+        // photons shifted to the bunch crossing, digitized with the signal
+        for (const auto& photon : background.event->photons)
+            fSipmPhotons.emplace_back(photon.first, photon.second + background.offset);
+
+        if (!background.inEdepWindow) continue;
+        for (const auto& deposit : background.event->deposits){
+            if (deposit.sector == NSector){
+                if (deposit.module >= G4int(EEmcModule.size())) continue;
+                EEmcModule[deposit.module] += deposit.edepSen;
+                fPbWO4TotalEdep += deposit.edepSen;
+            }
+            else if (deposit.sector >= 0 && deposit.sector < NSector){
+                if (deposit.module >= G4int(ModEdepSen[deposit.sector].size())) continue;
+                ModEdepSen[deposit.sector][deposit.module] += deposit.edepSen;
+                ModEdepAbs[deposit.sector][deposit.module] += deposit.edepAbs;
+                fSecEdepTotSen[deposit.sector] += deposit.edepSen;
+                fSecEdepTotAbs[deposit.sector] += deposit.edepAbs;
+            }
+        }
+    }
+}
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 
     void EventAction::SetNewValueInt(G4String key, G4int value){
         if(key == "NEmc"){
@@ -286,6 +522,25 @@ void EventAction::EndOfEventAction(const G4Event *event)
             fNShash = value;
             G4cout << "Set NShash value in EventAction = " << value << G4endl;
         }
+        if(key == "CellEdep"){
+            fCellEdep = value;
+            G4cout << "Set CellEdep value in EventAction = " << value << G4endl;
+        }
+        if(key == "SipmRawHits"){
+            fSipmRawHits = value;
+            G4cout << "Set SipmRawHits value in EventAction = " << value << G4endl;
+        }
+        if(key == "SparseModules"){
+            fSparseModules = value;
+            G4cout << "Set SparseModules value in EventAction = " << value << G4endl;
+        }
+    }
+
+    void EventAction::SetNewValueDouble(G4String key, G4double value){
+        if(key == "ZeroSuppression"){
+            fZeroSuppression = value;
+            G4cout << "Set ZeroSuppression value in EventAction = " << value << G4endl;
+        }
     }
 
 } // namespace ZDC
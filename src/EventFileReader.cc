@@ -0,0 +1,259 @@
+#include "EventFileReader.hh"
+
+#include "G4PhysicalConstants.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+constexpr char kMagic[8] = {'Z', 'D', 'C', 'G', 'E', 'N', '0', '1'};
+
+template <typename T>
+void Put(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+G4bool Get(std::istream& in, T& value)
+{
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// "@ x y z t" at the end of a HepMC3 E or V line
+G4bool ReadPosition(const std::string& line, G4double position[4])
+{
+    auto at = line.find('@');
+    if (at == std::string::npos) return false;
+    std::istringstream is(line.substr(at + 1));
+    return bool(is >> position[0] >> position[1] >> position[2] >> position[3]);
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<EventFileReader> EventFileReader::Open(const G4String& fileName, long firstEvent)
+{
+    static std::mutex mutex;
+    static std::map<G4String, std::shared_ptr<EventFileReader>> readers;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& reader = readers[fileName];
+    if (!reader) reader = std::make_shared<EventFileReader>(fileName, true, firstEvent);
+    return reader;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventFileReader::EventFileReader(const G4String& fileName, G4bool readAhead, long firstEvent)
+  : fFileName(fileName), fIn(fileName, std::ios::binary), fFirstEvent(firstEvent), fRunOffset(firstEvent)
+{
+    char magic[sizeof(kMagic)];
+    if (!fIn) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open event file " << fileName;
+        G4Exception("EventFileReader::EventFileReader()", "MyCode0015", FatalException, msg);
+        return;
+    }
+    fBinary = fIn.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+    if (!fBinary) {
+        fIn.clear();
+        fIn.seekg(0);
+    }
+
+    if (readAhead) fThread = std::thread(&EventFileReader::ReadAhead, this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventFileReader::~EventFileReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fTaken.notify_all();
+    if (fThread.joinable()) fThread.join();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventFileReader::ReadAhead()
+{
+    while (true) {
+        GenEvent event;
+        G4bool ok = Read(event);
+
+        std::unique_lock<std::mutex> lock(fMutex);
+        if (!ok) {
+            fEnd = true;
+            fFilled.notify_all();
+            return;
+        }
+        if (fNextIndex < fFirstEvent) {
+            fNextIndex++;
+            continue;
+        }
+        fBuffer.emplace(fNextIndex++, std::move(event));
+        fFilled.notify_all();
+        fTaken.wait(lock, [this] { return fStop || fBuffer.size() < kBufferSize || fMaxWanted >= fNextIndex; });
+        if (fStop) return;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EventFileReader::Take(G4int runID, G4int eventID, GenEvent& event)
+{
+    std::unique_lock<std::mutex> lock(fMutex);
+    if (runID != fRunID) {
+        fRunOffset += fRunEvents;
+        fRunEvents = 0;
+        fRunID = runID;
+    }
+    fRunEvents = std::max(fRunEvents, long(eventID) + 1);
+
+    const long index = fRunOffset + eventID;
+    if (index >= fNextIndex) {
+        fMaxWanted = std::max(fMaxWanted, index);
+        fTaken.notify_all();
+        fFilled.wait(lock, [&] { return index < fNextIndex || fEnd; });
+    }
+
+    auto it = fBuffer.find(index);
+    if (it == fBuffer.end()) return false;
+    event = std::move(it->second);
+    fBuffer.erase(it);
+    fTaken.notify_all();
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EventFileReader::Read(GenEvent& event)
+{
+    event.vertices.clear();
+    return fBinary ? ReadBinary(event) : ReadHepMC(event);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EventFileReader::ReadHepMC(GenEvent& event)
+{
+    std::string line;
+    while (fPendingLine.empty() && std::getline(fIn, line)) {
+        if (line.compare(0, 2, "E ") == 0) fPendingLine = line;
+    }
+    if (fPendingLine.empty()) return false;
+
+    G4double eventPosition[4] = {0., 0., 0., 0.};
+    ReadPosition(fPendingLine, eventPosition);
+    fPendingLine.clear();
+
+    // final-state particles by production vertex (negative vertex ID, or the
+    // parent particle ID when the vertex is implicit), positions of the V lines
+    std::map<G4int, std::vector<GenParticle>> particles;
+    std::map<G4int, std::array<G4double, 4>> positions;
+    while (std::getline(fIn, line)) {
+        if (line.compare(0, 2, "E ") == 0) {
+            fPendingLine = line;
+            break;
+        }
+        std::istringstream is(line);
+        G4String tag;
+        if (!(is >> tag)) continue;
+        if (tag == "U") {
+            G4String momentum, length;
+            is >> momentum >> length;
+            fMomentumUnit = momentum == "MEV" ? CLHEP::MeV : CLHEP::GeV;
+            fLengthUnit = length == "CM" ? CLHEP::cm : CLHEP::mm;
+        }
+        else if (tag == "V") {
+            G4int id;
+            std::array<G4double, 4> position;
+            if (is >> id && ReadPosition(line, position.data())) positions[id] = position;
+        }
+        else if (tag == "P") {
+            G4int id, mother, pdg, status;
+            G4double px, py, pz, e, m;
+            if (!(is >> id >> mother >> pdg >> px >> py >> pz >> e >> m >> status) || status != 1) continue;
+            particles[mother].push_back({pdg, G4ThreeVector(px, py, pz) * fMomentumUnit});
+        }
+    }
+
+    for (auto& [vertexID, vertexParticles] : particles) {
+        GenVertex vertex;
+        const G4double* position = eventPosition;
+        auto it = positions.find(vertexID);
+        if (vertexID < 0 && it != positions.end()) position = it->second.data();
+        vertex.position = G4ThreeVector(position[0], position[1], position[2]) * fLengthUnit;
+        vertex.time = position[3] * fLengthUnit / CLHEP::c_light;
+        vertex.particles = std::move(vertexParticles);
+        event.vertices.push_back(std::move(vertex));
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EventFileReader::ReadBinary(GenEvent& event)
+{
+    std::uint32_t nVertices;
+    if (!Get(fIn, nVertices)) return false;
+    event.vertices.resize(nVertices);
+    for (auto& vertex : event.vertices) {
+        G4double x, y, z, t;
+        std::uint32_t nParticles;
+        if (!Get(fIn, x) || !Get(fIn, y) || !Get(fIn, z) || !Get(fIn, t) || !Get(fIn, nParticles)) return false;
+        vertex.position = G4ThreeVector(x, y, z) * CLHEP::mm;
+        vertex.time = t * CLHEP::ns;
+        vertex.particles.resize(nParticles);
+        for (auto& particle : vertex.particles) {
+            std::int32_t pdg;
+            G4double px, py, pz;
+            if (!Get(fIn, pdg) || !Get(fIn, px) || !Get(fIn, py) || !Get(fIn, pz)) return false;
+            particle.pdg = pdg;
+            particle.momentum = G4ThreeVector(px, py, pz) * CLHEP::MeV;
+        }
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventFileReader::WriteBinaryHeader(std::ostream& out)
+{
+    out.write(kMagic, sizeof(kMagic));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventFileReader::WriteBinary(std::ostream& out, const GenEvent& event)
+{
+    Put<std::uint32_t>(out, event.vertices.size());
+    for (const auto& vertex : event.vertices) {
+        Put(out, vertex.position.x() / CLHEP::mm);
+        Put(out, vertex.position.y() / CLHEP::mm);
+        Put(out, vertex.position.z() / CLHEP::mm);
+        Put(out, vertex.time / CLHEP::ns);
+        Put<std::uint32_t>(out, vertex.particles.size());
+        for (const auto& particle : vertex.particles) {
+            Put<std::int32_t>(out, particle.pdg);
+            Put(out, particle.momentum.x() / CLHEP::MeV);
+            Put(out, particle.momentum.y() / CLHEP::MeV);
+            Put(out, particle.momentum.z() / CLHEP::MeV);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -6,6 +6,7 @@
 #include "G4UIcmdWithADouble.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithALongInt.hh"
+#include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIdirectory.hh"
 
@@ -29,6 +30,144 @@ EventMessenger::EventMessenger(EventAction* Evt) : fEventAction(Evt)
   fNShash = new G4UIcmdWithALongInt("/det/Shash/NModule", this);
   fNShash->AvailableForStates(G4State_PreInit, G4State_Idle); 
 
+  // output control
+  fEvtDirectory = new G4UIdirectory("/evt/");
+  fEvtDirectory->SetGuidance("Event output control");
+
+  fSparseModules = new G4UIcmdWithABool("/evt/SparseModules", this);
+  fSparseModules->SetGuidance("Store Mod.* arrays as (module index, value) pairs instead of dense vectors.");
+  fSparseModules->SetGuidance("Dense Mod.* columns are then written empty, sparse ones go to Mod.Idx*/Mod.Sp*.");
+  fSparseModules->SetParameterName("sparse", true);
+  fSparseModules->SetDefaultValue(true);
+  fSparseModules->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCellEdep = new G4UIcmdWithABool("/evt/CellEdep", this);
+  fCellEdep->SetGuidance("Store the sensitive and absorber edep of every (module, layer) cell");
+  fCellEdep->SetGuidance("in Cell.EdepSecSen*/Cell.EdepSecAbs*, index module*NLayer + layer.");
+  fCellEdep->SetParameterName("cell", true);
+  fCellEdep->SetDefaultValue(true);
+  fCellEdep->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fZeroSuppression = new G4UIcmdWithADoubleAndUnit("/evt/ZeroSuppression", this);
+  fZeroSuppression->SetGuidance("Zero-suppression threshold for the sparse module arrays.");
+  fZeroSuppression->SetGuidance("A module is kept if its sensitive or absorber edep is above it, or if it has NPE > 0.");
+  fZeroSuppression->SetParameterName("threshold", false);
+  fZeroSuppression->SetRange("threshold >= 0");
+  fZeroSuppression->SetDefaultUnit("MeV");
+  fZeroSuppression->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // SiPM digitization
+  fDigiDirectory = new G4UIdirectory("/digi/");
+  fDigiDirectory->SetGuidance("Digitization control");
+  fSipmDirectory = new G4UIdirectory("/digi/Sipm/");
+  fSipmDirectory->SetGuidance("SiPM response: PDE, crosstalk, afterpulses, dark counts, pulse shape and discriminator.");
+
+  auto probability = [this](const char* name, const char* guidance) {
+    auto cmd = new G4UIcmdWithADouble(name, this);
+    cmd->SetGuidance(guidance);
+    cmd->SetParameterName("p", false);
+    cmd->SetRange("p >= 0 && p < 1");
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    return cmd;
+  };
+  auto duration = [this](const char* name, const char* guidance, const char* range) {
+    auto cmd = new G4UIcmdWithADoubleAndUnit(name, this);
+    cmd->SetGuidance(guidance);
+    cmd->SetParameterName("t", false);
+    if (range) cmd->SetRange(range);
+    cmd->SetDefaultUnit("ns");
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    return cmd;
+  };
+
+  fSipmPDE = new G4UIcmdWithADouble("/digi/Sipm/PDE", this);
+  fSipmPDE->SetGuidance("Relative photon detection efficiency, on top of the EFFICIENCY of the SiPM surface (default 1).");
+  fSipmPDE->SetParameterName("pde", false);
+  fSipmPDE->SetRange("pde >= 0 && pde <= 1");
+  fSipmPDE->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSipmCrosstalk = probability("/digi/Sipm/Crosstalk", "Probability that a fired cell fires a neighbour (default 0.03).");
+  fSipmAfterpulse = probability("/digi/Sipm/Afterpulse", "Afterpulse probability per fired cell (default 0.01).");
+  fSipmAfterpulseTime = duration("/digi/Sipm/AfterpulseTime", "Mean afterpulse delay (default 15 ns).", "t > 0");
+  fSipmRecoveryTime = duration("/digi/Sipm/RecoveryTime", "Cell recovery time, scales the afterpulse amplitude (default 20 ns).", "t >= 0");
+  fSipmGateStart = duration("/digi/Sipm/GateStart", "Start of the readout gate of 256 samples (default 0 ns).", nullptr);
+  fSipmSampleWidth = duration("/digi/Sipm/SampleWidth", "Sampling period (default 0.5 ns, gate 128 ns).", "t > 0");
+  fSipmRiseTime = duration("/digi/Sipm/RiseTime", "Rise time of the single p.e. pulse (default 1 ns).", "t >= 0");
+  fSipmFallTime = duration("/digi/Sipm/FallTime", "Fall time of the single p.e. pulse (default 20 ns).", "t > 0");
+
+  fSipmDarkRate = new G4UIcmdWithADoubleAndUnit("/digi/Sipm/DarkRate", this);
+  fSipmDarkRate->SetGuidance("Dark count rate per SiPM (default 100 kHz).");
+  fSipmDarkRate->SetParameterName("rate", false);
+  fSipmDarkRate->SetRange("rate >= 0");
+  fSipmDarkRate->SetDefaultUnit("kHz");
+  fSipmDarkRate->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSipmGainSpread = new G4UIcmdWithADouble("/digi/Sipm/GainSpread", this);
+  fSipmGainSpread->SetGuidance("Relative gain spread of the fired cells (default 0.1).");
+  fSipmGainSpread->SetParameterName("sigma", false);
+  fSipmGainSpread->SetRange("sigma >= 0");
+  fSipmGainSpread->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSipmThreshold = new G4UIcmdWithADouble("/digi/Sipm/Threshold", this);
+  fSipmThreshold->SetGuidance("Discriminator threshold in p.e. (default 0.5), SiPMs below it are not stored.");
+  fSipmThreshold->SetParameterName("pe", false);
+  fSipmThreshold->SetRange("pe > 0");
+  fSipmThreshold->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSipmRawHits = new G4UIcmdWithABool("/digi/Sipm/RawHits", this);
+  fSipmRawHits->SetGuidance("Also store every detected photon in Sipm.HitID/Sipm.HitTime.");
+  fSipmRawHits->SetParameterName("raw", true);
+  fSipmRawHits->SetDefaultValue(true);
+  fSipmRawHits->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // pile-up overlay
+  fPileupDirectory = new G4UIdirectory("/pileup/");
+  fPileupDirectory->SetGuidance("Overlay of background event responses from a pile-up library.");
+
+  fPileupLibrary = new G4UIcmdWithAString("/pileup/Library", this);
+  fPileupLibrary->SetGuidance("Library file the background events are drawn from, none to switch the overlay off.");
+  fPileupLibrary->SetParameterName("file", false);
+  fPileupLibrary->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupWriteLibrary = new G4UIcmdWithAString("/pileup/WriteLibrary", this);
+  fPileupWriteLibrary->SetGuidance("Append the response of every event to this library file, none to stop.");
+  fPileupWriteLibrary->SetGuidance("Run it with the minimum-bias generator settings; the file is rewritten at its first event.");
+  fPileupWriteLibrary->SetParameterName("file", false);
+  fPileupWriteLibrary->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupMu = new G4UIcmdWithADouble("/pileup/Mu", this);
+  fPileupMu->SetGuidance("Mean number of background events per bunch crossing (Poisson), 0 switches the overlay off.");
+  fPileupMu->SetParameterName("mu", false);
+  fPileupMu->SetRange("mu >= 0");
+  fPileupMu->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupBunchSpacing = new G4UIcmdWithADoubleAndUnit("/pileup/BunchSpacing", this);
+  fPileupBunchSpacing->SetGuidance("Time between bunch crossings (default 25 ns).");
+  fPileupBunchSpacing->SetParameterName("spacing", false);
+  fPileupBunchSpacing->SetRange("spacing > 0");
+  fPileupBunchSpacing->SetDefaultUnit("ns");
+  fPileupBunchSpacing->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupBunchesBefore = new G4UIcmdWithALongInt("/pileup/BunchesBefore", this);
+  fPileupBunchesBefore->SetGuidance("Crossings before the signal one with background (default 5).");
+  fPileupBunchesBefore->SetParameterName("n", false);
+  fPileupBunchesBefore->SetRange("n >= 0");
+  fPileupBunchesBefore->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupBunchesAfter = new G4UIcmdWithALongInt("/pileup/BunchesAfter", this);
+  fPileupBunchesAfter->SetGuidance("Crossings after the signal one with background (default 5).");
+  fPileupBunchesAfter->SetParameterName("n", false);
+  fPileupBunchesAfter->SetRange("n >= 0");
+  fPileupBunchesAfter->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPileupEdepWindow = new G4UIcmdWithADoubleAndUnit("/pileup/EdepWindow", this);
+  fPileupEdepWindow->SetGuidance("Module edeps of the background are added for crossings within this time of the signal");
+  fPileupEdepWindow->SetGuidance("(default 0: in-time crossing only); SiPM photons are overlaid for all crossings.");
+  fPileupEdepWindow->SetParameterName("window", false);
+  fPileupEdepWindow->SetRange("window >= 0");
+  fPileupEdepWindow->SetDefaultUnit("ns");
+  fPileupEdepWindow->AvailableForStates(G4State_PreInit, G4State_Idle);
+
   // fDoubleInput = new G4UIcmdWithADouble("/det/setDValue", this);
   // fDoubleInput->SetGuidance("Set a Double value");
   // fDoubleInput->SetParameterName("DValue", false);
@@ -44,6 +183,33 @@ EventMessenger::~EventMessenger()
   delete fChamMatCmd;
   delete fStepMaxCmd;
   delete fDoubleInput;
+  delete fSparseModules;
+  delete fZeroSuppression;
+  delete fCellEdep;
+  delete fSipmPDE;
+  delete fSipmCrosstalk;
+  delete fSipmAfterpulse;
+  delete fSipmAfterpulseTime;
+  delete fSipmRecoveryTime;
+  delete fSipmDarkRate;
+  delete fSipmGainSpread;
+  delete fSipmThreshold;
+  delete fSipmGateStart;
+  delete fSipmSampleWidth;
+  delete fSipmRiseTime;
+  delete fSipmFallTime;
+  delete fSipmRawHits;
+  delete fSipmDirectory;
+  delete fDigiDirectory;
+  delete fPileupLibrary;
+  delete fPileupWriteLibrary;
+  delete fPileupMu;
+  delete fPileupBunchSpacing;
+  delete fPileupBunchesBefore;
+  delete fPileupBunchesAfter;
+  delete fPileupEdepWindow;
+  delete fPileupDirectory;
+  delete fEvtDirectory;
   delete fDetDirectory;
 }
 
@@ -62,6 +228,55 @@ void EventMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   if (command == fNShash) {
     fEventAction->SetNewValueInt("NShash", fNShash->GetNewLongIntValue(newValue));
   }
+
+  if (command == fSparseModules) {
+    fEventAction->SetNewValueInt("SparseModules", fSparseModules->GetNewBoolValue(newValue));
+  }
+
+  if (command == fCellEdep) {
+    fEventAction->SetNewValueInt("CellEdep", fCellEdep->GetNewBoolValue(newValue));
+  }
+
+  if (command == fZeroSuppression) {
+    fEventAction->SetNewValueDouble("ZeroSuppression", fZeroSuppression->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fSipmRawHits) {
+    fEventAction->SetNewValueInt("SipmRawHits", fSipmRawHits->GetNewBoolValue(newValue));
+  }
+
+  // SiPM digitizer parameters, the key is the command name
+  if (command == fSipmPDE || command == fSipmCrosstalk || command == fSipmAfterpulse
+      || command == fSipmGainSpread || command == fSipmThreshold) {
+    fEventAction->GetSipmDigitizer().SetNewValueDouble(command->GetCommandName(),
+                                                       G4UIcommand::ConvertToDouble(newValue));
+  }
+
+  if (command == fSipmAfterpulseTime || command == fSipmRecoveryTime || command == fSipmDarkRate
+      || command == fSipmGateStart || command == fSipmSampleWidth || command == fSipmRiseTime
+      || command == fSipmFallTime) {
+    fEventAction->GetSipmDigitizer().SetNewValueDouble(command->GetCommandName(),
+                                                       G4UIcommand::ConvertToDimensionedDouble(newValue));
+  }
+
+  // pile-up overlay, the key is the command name
+  if (command == fPileupLibrary || command == fPileupWriteLibrary) {
+    fEventAction->GetPileupOverlay().SetNewValueString(command->GetCommandName(), newValue);
+  }
+
+  if (command == fPileupMu) {
+    fEventAction->GetPileupOverlay().SetNewValueDouble("Mu", fPileupMu->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fPileupBunchSpacing || command == fPileupEdepWindow) {
+    fEventAction->GetPileupOverlay().SetNewValueDouble(command->GetCommandName(),
+                                                       G4UIcommand::ConvertToDimensionedDouble(newValue));
+  }
+
+  if (command == fPileupBunchesBefore || command == fPileupBunchesAfter) {
+    fEventAction->GetPileupOverlay().SetNewValueInt(command->GetCommandName(),
+                                                    G4UIcommand::ConvertToInt(newValue));
+  }
   
 }
 
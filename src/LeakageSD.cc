@@ -0,0 +1,90 @@
+#include "LeakageSD.hh"
+
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4Neutron.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4Positron.hh"
+#include "G4Step.hh"
+#include "G4VPhysicalVolume.hh"
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// outward normals of the plates by copy number: front, back, +x, -x, +y, -y
+const G4ThreeVector kNormals[6] = {{0., 0., -1.}, {0., 0., 1.}, {1., 0., 0.},
+                                   {-1., 0., 0.}, {0., 1., 0.}, {0., -1., 0.}};
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LeakageSD::LeakageSD(const G4String& name)
+  : G4VSensitiveDetector(name),
+    fOpticalPhoton(G4OpticalPhoton::Definition()),
+    fGamma(G4Gamma::Definition()),
+    fElectron(G4Electron::Definition()),
+    fPositron(G4Positron::Definition()),
+    fMuonMinus(G4MuonMinus::Definition()),
+    fMuonPlus(G4MuonPlus::Definition()),
+    fNeutron(G4Neutron::Definition())
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LeakageSD::Initialize(G4HCofThisEvent*)
+{
+    fEnergy.fill(0.);
+    fKineticEnergy = 0.;
+    fNonBaryonMass = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool LeakageSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    G4StepPoint* prePoint = step->GetPreStepPoint();
+    if (prePoint->GetStepStatus() != fGeomBoundary) return false;
+
+    // only tracks going out, the beam enters through the front plate
+    G4int copy = prePoint->GetPhysicalVolume()->GetCopyNo();
+    if (copy < 0 || copy > 5 || prePoint->GetMomentumDirection().dot(kNormals[copy]) <= 0.) return false;
+
+    G4Track* track = step->GetTrack();
+    track->SetTrackStatus(fStopAndKill);
+
+    const G4ParticleDefinition* particle = track->GetParticleDefinition();
+    if (particle == fOpticalPhoton) return false;
+
+    G4int face = copy < kLeakSide ? copy : kLeakSide;
+    G4double energy = prePoint->GetKineticEnergy();
+    fEnergy[face * kNLeakClass + Classify(particle)] += energy;
+    fKineticEnergy += energy;
+    if (particle->GetBaryonNumber() == 0) fNonBaryonMass += particle->GetPDGMass();
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LeakageClass LeakageSD::Classify(const G4ParticleDefinition* particle) const
+{
+    if (particle == fGamma) return kLeakGamma;
+    if (particle == fElectron || particle == fPositron) return kLeakElectron;
+    if (particle == fMuonMinus || particle == fMuonPlus) return kLeakMuon;
+    if (particle == fNeutron) return kLeakNeutron;
+    if (particle->GetPDGCharge() != 0. && particle->GetLeptonNumber() == 0 && particle->GetBaryonNumber() <= 1
+        && particle->GetBaryonNumber() >= -1)
+        return kLeakChargedHadron;
+    // neutrinos, neutral hadrons other than the neutron, ions
+    return kLeakOther;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -0,0 +1,99 @@
+#include "Logger.hh"
+
+#include "G4Threading.hh"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+const char* kLevelNames[] = {"debug", "info", "warning"};
+
+struct TagState
+{
+    std::chrono::steady_clock::time_point windowStart;
+    G4int printed = 0;
+    G4long suppressed = 0;
+};
+
+// shared by the threads, only touched by the recorded messages
+std::mutex gMutex;
+std::vector<std::string> gRing;
+std::size_t gNext = 0;
+std::map<std::string, TagState> gTags;
+}  // namespace
+
+std::atomic<G4int> Logger::fLevel{Logger::kInfo};
+std::atomic<G4int> Logger::fRateLimit{10};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool Logger::SetLevel(const G4String& name)
+{
+    if (name == "debug") fLevel = kDebug;
+    else if (name == "info") fLevel = kInfo;
+    else if (name == "production") fLevel = kWarning;
+    else return false;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Logger::Log(Level level, const G4String& tag, const G4String& message)
+{
+    if (!IsEnabled(level)) return;
+
+    const G4int thread = G4Threading::G4GetThreadId();
+    const std::string record = (thread < 0 ? std::string("M") : "W" + std::to_string(thread)) + " "
+                               + kLevelNames[level] + " " + tag + ": " + message;
+
+    G4bool print = level >= fLevel;
+    G4long suppressed = 0;
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        if (gRing.size() < kRingSize) gRing.push_back(record);
+        else gRing[gNext % kRingSize] = record;
+        gNext++;
+
+        if (print && fRateLimit > 0) {
+            auto& state = gTags[tag];
+            const auto now = std::chrono::steady_clock::now();
+            if (now - state.windowStart >= std::chrono::seconds(1)) {
+                state.windowStart = now;
+                state.printed = 0;
+                suppressed = state.suppressed;
+                state.suppressed = 0;
+            }
+            if (state.printed < fRateLimit) state.printed++;
+            else {
+                state.suppressed++;
+                print = false;
+            }
+        }
+    }
+    if (!print) return;
+
+    if (suppressed > 0) G4cout << "(" << suppressed << " " << tag << " messages not printed, /log/Dump)" << G4endl;
+    G4cout << message << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Logger::Dump()
+{
+    std::lock_guard<std::mutex> lock(gMutex);
+    G4cout << "Last " << gRing.size() << " of " << gNext << " log messages:" << G4endl;
+    for (std::size_t i = gNext - gRing.size(); i < gNext; i++) G4cout << gRing[i % kRingSize] << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -0,0 +1,73 @@
+#include "LoggerMessenger.hh"
+
+#include "Logger.hh"
+
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIdirectory.hh"
+
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LoggerMessenger::LoggerMessenger()
+{
+  // master only, the log settings are shared by the threads
+  fLogDirectory = new G4UIdirectory("/log/", false);
+  fLogDirectory->SetGuidance("Application log levels, rate limit and ring buffer");
+
+  fLevel = new G4UIcmdWithAString("/log/Level", this);
+  fLevel->SetGuidance("Print level: debug (e.g. each placed volume), info (default, progress every");
+  fLevel->SetGuidance("/run/printProgress events) or production (warnings only).");
+  fLevel->SetParameterName("level", false);
+  fLevel->SetCandidates("debug info production");
+  fLevel->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fLevel->SetToBeBroadcasted(false);
+
+  fRateLimit = new G4UIcmdWithAnInteger("/log/RateLimit", this);
+  fRateLimit->SetGuidance("Messages printed per tag and second (default 10), 0 for no limit.");
+  fRateLimit->SetGuidance("The others are only kept in the ring, see /log/Dump.");
+  fRateLimit->SetParameterName("n", false);
+  fRateLimit->SetRange("n >= 0");
+  fRateLimit->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fRateLimit->SetToBeBroadcasted(false);
+
+  fDump = new G4UIcmdWithoutParameter("/log/Dump", this);
+  fDump->SetGuidance("Print the last 1000 messages of all threads, also the ones not printed.");
+  fDump->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDump->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LoggerMessenger::~LoggerMessenger()
+{
+  delete fLevel;
+  delete fRateLimit;
+  delete fDump;
+  delete fLogDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LoggerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fLevel) {
+    Logger::SetLevel(newValue);
+  }
+
+  if (command == fRateLimit) {
+    Logger::SetRateLimit(fRateLimit->GetNewIntValue(newValue));
+  }
+
+  if (command == fDump) {
+    Logger::Dump();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
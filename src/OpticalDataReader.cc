@@ -0,0 +1,182 @@
+#include "OpticalDataReader.hh"
+#include "UniformPropertyVector.hh"
+
+#include "G4UnitsTable.hh"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// "1" for dimensionless values, "1/X" for inverse units; 0 if unknown
+G4double UnitValue(const G4String& unit)
+{
+    if (unit == "1") return 1.;
+    if (unit.size() > 2 && unit.compare(0, 2, "1/") == 0) {
+        G4String denominator = unit.substr(2);
+        if (!G4UnitDefinition::IsUnitDefined(denominator)) return 0.;
+        return 1. / G4UnitDefinition::GetValueOf(denominator);
+    }
+    if (!G4UnitDefinition::IsUnitDefined(unit)) return 0.;
+    return G4UnitDefinition::GetValueOf(unit);
+}
+
+template <typename T>
+G4bool Lookup(const std::map<G4String, T>& names, const G4String& name, T& value)
+{
+    auto it = names.find(name);
+    if (it == names.end()) return false;
+    value = it->second;
+    return true;
+}
+
+const std::map<G4String, G4OpticalSurfaceModel> kModels = {
+    {"glisur", glisur}, {"unified", unified}, {"LUT", LUT}, {"DAVIS", DAVIS}, {"dichroic", dichroic}};
+
+const std::map<G4String, G4OpticalSurfaceFinish> kFinishes = {
+    {"polished", polished},
+    {"polishedfrontpainted", polishedfrontpainted},
+    {"polishedbackpainted", polishedbackpainted},
+    {"ground", ground},
+    {"groundfrontpainted", groundfrontpainted},
+    {"groundbackpainted", groundbackpainted},
+    {"polishedair", polishedair},
+    {"groundair", groundair}};
+
+const std::map<G4String, G4SurfaceType> kTypes = {
+    {"dielectric_metal", dielectric_metal},
+    {"dielectric_dielectric", dielectric_dielectric},
+    {"dielectric_LUT", dielectric_LUT},
+    {"dielectric_LUTDAVIS", dielectric_LUTDAVIS},
+    {"dielectric_dichroic", dielectric_dichroic}};
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+OpticalDataReader::OpticalDataReader(const G4String& directory, G4double binWidth)
+  : fDirectory(directory), fBinWidth(binWidth)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4MaterialPropertiesTable* OpticalDataReader::ReadMaterial(const G4String& name) const
+{
+    SurfaceSettings surface;
+    auto table = Read(name, surface);
+    if (surface.defined) Fail(name, 0, "surface settings in a material file");
+    if (!table) Fail(name, 0, "no properties");
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4OpticalSurface* OpticalDataReader::ReadSurface(const G4String& name, const G4String& surfaceName) const
+{
+    SurfaceSettings surface;
+    auto table = Read(name, surface);
+    if (!surface.defined) Fail(name, 0, "no surface line");
+
+    auto opSurface = new G4OpticalSurface(surfaceName, surface.model, surface.finish, surface.type, surface.value);
+    if (table) opSurface->SetMaterialPropertiesTable(table);
+    return opSurface;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// the table, nullptr if the file has no properties
+G4MaterialPropertiesTable* OpticalDataReader::Read(const G4String& name, SurfaceSettings& surface) const
+{
+    G4String fileName = fDirectory + "/" + name + ".dat";
+    std::ifstream in(fileName);
+    if (!in) {
+        Fail(name, 0, "cannot open " + fileName);
+        return nullptr;
+    }
+
+    auto table = new G4MaterialPropertiesTable();
+    G4bool empty = true;
+
+    std::string line;
+    G4int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream is(line);
+        G4String keyword;
+        if (!(is >> keyword)) continue;
+
+        if (keyword == "surface") {
+            G4String model, finish, type;
+            if (!(is >> model >> finish >> type >> surface.value) || !Lookup(kModels, model, surface.model)
+                || !Lookup(kFinishes, finish, surface.finish) || !Lookup(kTypes, type, surface.type))
+                Fail(name, lineNumber, "bad surface line");
+            surface.defined = true;
+        }
+        else if (keyword == "const") {
+            G4String property, unit;
+            G4double value;
+            if (!(is >> property >> value >> unit) || UnitValue(unit) == 0.)
+                Fail(name, lineNumber, "bad const line");
+            table->AddConstProperty(property, value * UnitValue(unit));
+            empty = false;
+        }
+        else {
+            // property vector, rows up to "end"
+            G4String energyUnit, valueUnit;
+            if (!(is >> energyUnit >> valueUnit) || UnitValue(energyUnit) == 0. || UnitValue(valueUnit) == 0.)
+                Fail(name, lineNumber, "bad header of property " + keyword);
+            std::vector<G4double> energies, values;
+            G4bool closed = false;
+            while (std::getline(in, line)) {
+                lineNumber++;
+                line = line.substr(0, line.find('#'));
+                std::istringstream row(line);
+                G4String first;
+                if (!(row >> first)) continue;
+                if (first == "end") {
+                    closed = true;
+                    break;
+                }
+                G4double energy, value;
+                row.clear();
+                row.seekg(0);
+                if (!(row >> energy >> value)) Fail(name, lineNumber, "bad row of property " + keyword);
+                energy *= UnitValue(energyUnit);
+                if (energies.size() && energy <= energies.back())
+                    Fail(name, lineNumber, "energies of " + keyword + " not increasing");
+                energies.push_back(energy);
+                values.push_back(value * UnitValue(valueUnit));
+            }
+            if (!closed || energies.size() < 2) Fail(name, lineNumber, "property " + keyword + " needs 2 rows and end");
+            table->AddProperty(keyword, UniformPropertyVector::Create(energies, values, fBinWidth));
+            empty = false;
+        }
+    }
+
+    if (empty) {
+        delete table;
+        return nullptr;
+    }
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OpticalDataReader::Fail(const G4String& name, G4int line, const G4String& message) const
+{
+    std::ostringstream o;
+    o << "Optical data " << fDirectory << "/" << name << ".dat";
+    if (line > 0) o << ", line " << line;
+    o << ": " << message;
+    G4Exception("OpticalDataReader::Read", "MyCode0012", FatalException, o.str().c_str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -0,0 +1,182 @@
+#include "PhysicsTableCache.hh"
+#include "ZDCHash.hh"
+
+#include "G4EmParameters.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4StateManager.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <system_error>
+#include <unistd.h>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// materials of a region, without the daughters that start another region
+void CollectMaterials(const G4LogicalVolume* lv, const G4Region* region,
+                      std::set<const G4LogicalVolume*>& visited,
+                      std::map<G4String, const G4Material*>& materials)
+{
+    if (!visited.insert(lv).second) return;
+    if (lv->GetMaterial()) materials[lv->GetMaterial()->GetName()] = lv->GetMaterial();
+    for (std::size_t i = 0; i < lv->GetNoDaughters(); i++) {
+        auto daughter = lv->GetDaughter(i)->GetLogicalVolume();
+        if (daughter->IsRootRegion() && daughter->GetRegion() != region) continue;
+        CollectMaterials(daughter, region, visited, materials);
+    }
+}
+
+void AddMaterial(Fnv1a& h, const G4Material* mat)
+{
+    h.Add(mat->GetName());
+    h.Add(mat->GetDensity());
+    h.Add(G4int(mat->GetState()));
+    h.Add(mat->GetTemperature());
+    h.Add(mat->GetPressure());
+    h.Add(mat->GetIonisation()->GetMeanExcitationEnergy());
+    for (std::size_t i = 0; i < mat->GetNumberOfElements(); i++) {
+        h.Add(mat->GetElement(i)->GetName());
+        h.Add(mat->GetFractionVector()[i]);
+    }
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsTableCache::PhysicsTableCache(G4VUserPhysicsList* physicsList, const G4String& directory)
+  : G4VStateDependent(), fPhysicsList(physicsList), fDirectory(directory)
+{
+    fStartupTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+    if (fDone) return true;
+
+    // the state manager still holds the old state during the notification
+    auto currentState = G4StateManager::GetStateManager()->GetCurrentState();
+
+    if (currentState == G4State_Idle && requestedState == G4State_Init) {
+        fBuilding = true;
+        fTableTimer.Start();
+        if (!fDirectory.empty()) {
+            fTableDirectory = fDirectory + "/" + ComputeKey();
+            if (std::filesystem::exists(fTableDirectory + "/complete")) {
+                fPhysicsList->SetPhysicsTableRetrieved(fTableDirectory);
+            }
+        }
+    }
+    else if (fBuilding && currentState == G4State_Init && requestedState == G4State_Idle) {
+        fTableTimer.Stop();
+        fBuilding = false;
+        fDone = true;
+
+        // false if the retrieval failed and Geant4 fell back to building the tables
+        fRetrieved = fPhysicsList->IsPhysicsTableRetrieved();
+        if (fRetrieved) {
+            fPhysicsList->ResetPhysicsTableRetrieved();
+        }
+        else if (!fDirectory.empty()) {
+            StoreTables();
+        }
+
+        fStartupTimer.Stop();
+        G4cout << "PhysicsTableCache: physics tables " << (fRetrieved ? "retrieved from " : "built")
+               << (fRetrieved ? fTableDirectory : G4String()) << " in " << fTableTimer.GetRealElapsed() << " s, "
+               << fStartupTimer.GetRealElapsed() << " s since start-up" << G4endl;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhysicsTableCache::ComputeKey() const
+{
+    Fnv1a h;
+    h.Add(std::string(G4Version));
+
+    if (auto modular = dynamic_cast<G4VModularPhysicsList*>(fPhysicsList)) {
+        const G4VPhysicsConstructor* physics = nullptr;
+        for (G4int i = 0; (physics = modular->GetPhysics(i)) != nullptr; i++) {
+            h.Add(physics->GetPhysicsName());
+        }
+    }
+
+    std::ostringstream emParameters;
+    G4EmParameters::Instance()->StreamInfo(emParameters);
+    h.Add(emParameters.str());
+
+    auto cutsTable = G4ProductionCutsTable::GetProductionCutsTable();
+    h.Add(fPhysicsList->GetDefaultCutValue());
+    h.Add(cutsTable->GetLowEdgeEnergy());
+    h.Add(cutsTable->GetHighEdgeEnergy());
+
+    // every region with its cuts and materials, i.e. the material-cuts couples
+    for (auto region : *G4RegionStore::GetInstance()) {
+        h.Add(region->GetName());
+        if (auto cuts = region->GetProductionCuts()) {
+            for (G4int i = 0; i < NumberOfG4CutIndex; i++) h.Add(cuts->GetProductionCut(i));
+        }
+        std::set<const G4LogicalVolume*> visited;
+        std::map<G4String, const G4Material*> materials;
+        auto root = region->GetRootLogicalVolumeIterator();
+        for (std::size_t i = 0; i < region->GetNumberOfRootVolumes(); i++, root++) {
+            CollectMaterials(*root, region, visited, materials);
+        }
+        for (const auto& material : materials) AddMaterial(h, material.second);
+    }
+
+    return h.Hex();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::StoreTables()
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    // store into a private directory first, so that jobs sharing the cache
+    // only ever see complete table sets
+    G4String tmpDirectory = fTableDirectory + ".tmp" + std::to_string(::getpid());
+    fs::create_directories(tmpDirectory, ec);
+    if (ec || !fPhysicsList->StorePhysicsTable(tmpDirectory)) {
+        G4ExceptionDescription msg;
+        msg << "Cannot store the physics tables in " << tmpDirectory;
+        G4Exception("PhysicsTableCache::StoreTables()", "MyCode0011", JustWarning, msg);
+        fs::remove_all(tmpDirectory, ec);
+        return;
+    }
+    std::ofstream(tmpDirectory + "/complete") << fTableDirectory << "\n";
+
+    // another job may have stored the same set in the meantime
+    fs::rename(tmpDirectory, fTableDirectory, ec);
+    if (ec) {
+        fs::remove_all(tmpDirectory, ec);
+        return;
+    }
+    G4cout << "PhysicsTableCache: physics tables stored in " << fTableDirectory << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
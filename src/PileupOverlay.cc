@@ -0,0 +1,228 @@
+#include "PileupOverlay.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Poisson.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+G4Mutex libraryMutex = G4MUTEX_INITIALIZER;
+
+constexpr char kMagic[8] = {'Z', 'D', 'C', 'P', 'I', 'L', 'E', '1'};
+
+template <typename T>
+void Put(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+G4bool Get(std::istream& in, T& value)
+{
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+G4bool ReadEvent(std::istream& in, PileupEvent& event)
+{
+    std::uint32_t nDeposits = 0;
+    if (!Get(in, nDeposits)) return false;
+    event.deposits.resize(nDeposits);
+    for (auto& deposit : event.deposits) {
+        std::int8_t sector;
+        std::int32_t module;
+        if (!Get(in, sector) || !Get(in, module) || !Get(in, deposit.edepSen) || !Get(in, deposit.edepAbs))
+            return false;
+        deposit.sector = sector;
+        deposit.module = module;
+    }
+
+    std::uint32_t nSipms = 0;
+    if (!Get(in, nSipms)) return false;
+    event.photons.clear();
+    for (std::uint32_t i = 0; i < nSipms; i++) {
+        std::int32_t id;
+        std::uint32_t n;
+        if (!Get(in, id) || !Get(in, n)) return false;
+        for (std::uint32_t j = 0; j < n; j++) {
+            G4float time;
+            if (!Get(in, time)) return false;
+            event.photons.emplace_back(id, time);
+        }
+    }
+    return true;
+}
+
+// library files written by this process, shared by the threads
+std::map<G4String, std::ofstream>& OutputFiles()
+{
+    static std::map<G4String, std::ofstream> files;
+    return files;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const PileupLibrary> PileupLibrary::Load(const G4String& fileName)
+{
+    G4AutoLock lock(&libraryMutex);
+    static std::map<G4String, std::shared_ptr<const PileupLibrary>> libraries;
+    auto& library = libraries[fileName];
+    if (library) return library;
+
+    // written by this process in an earlier run
+    auto output = OutputFiles().find(fileName);
+    if (output != OutputFiles().end()) output->second.flush();
+
+    auto loaded = std::make_shared<PileupLibrary>();
+    std::ifstream in(fileName, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    if (!in || !in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        G4ExceptionDescription msg;
+        msg << "Cannot read pile-up library " << fileName;
+        G4Exception("PileupLibrary::Load()", "MyCode0014", FatalException, msg);
+        return nullptr;
+    }
+    PileupEvent event;
+    while (in.peek() != EOF) {
+        if (!ReadEvent(in, event)) {
+            G4ExceptionDescription msg;
+            msg << "Truncated pile-up library " << fileName << " after " << loaded->fEvents.size() << " events";
+            G4Exception("PileupLibrary::Load()", "MyCode0014", FatalException, msg);
+            return nullptr;
+        }
+        loaded->fEvents.push_back(event);
+    }
+    G4cout << "Pile-up library " << fileName << ": " << loaded->fEvents.size() << " events" << G4endl;
+
+    library = loaded;
+    return library;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupLibrary::WriteHeader(std::ostream& out)
+{
+    out.write(kMagic, sizeof(kMagic));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupLibrary::WriteEvent(std::ostream& out, const PileupEvent& event)
+{
+    Put<std::uint32_t>(out, event.deposits.size());
+    for (const auto& deposit : event.deposits) {
+        Put<std::int8_t>(out, deposit.sector);
+        Put<std::int32_t>(out, deposit.module);
+        Put<G4float>(out, deposit.edepSen);
+        Put<G4float>(out, deposit.edepAbs);
+    }
+
+    // photons grouped by SiPM, in the order of the event
+    std::map<G4int, std::vector<G4float>> sipms;
+    for (const auto& photon : event.photons) sipms[photon.first].push_back(photon.second);
+    Put<std::uint32_t>(out, sipms.size());
+    for (const auto& [id, times] : sipms) {
+        Put<std::int32_t>(out, id);
+        Put<std::uint32_t>(out, times.size());
+        out.write(reinterpret_cast<const char*>(times.data()), times.size() * sizeof(G4float));
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupOverlay::Draw(std::vector<Background>& backgrounds)
+{
+    backgrounds.clear();
+    if (!IsActive()) return;
+    if (!fLibrary) fLibrary = PileupLibrary::Load(fLibraryFile);
+    if (!fLibrary || fLibrary->GetNumberOfEvents() == 0) return;
+
+    const std::size_t nEvents = fLibrary->GetNumberOfEvents();
+    for (G4int crossing = -fBunchesBefore; crossing <= fBunchesAfter; crossing++) {
+        G4double offset = crossing * fBunchSpacing;
+        G4bool inEdepWindow = std::abs(offset) <= fEdepWindow;
+        for (G4long n = G4Poisson(fMu); n > 0; n--) {
+            std::size_t i = std::min(nEvents - 1, std::size_t(G4UniformRand() * nEvents));
+            backgrounds.push_back({&fLibrary->GetEvent(i), offset, inEdepWindow});
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupOverlay::Record(const PileupEvent& event)
+{
+    G4AutoLock lock(&libraryMutex);
+    auto& files = OutputFiles();
+    auto it = files.find(fOutputFile);
+    if (it == files.end()) {
+        it = files.emplace(fOutputFile, std::ofstream(fOutputFile, std::ios::binary | std::ios::trunc)).first;
+        if (!it->second) {
+            G4ExceptionDescription msg;
+            msg << "Cannot write pile-up library " << fOutputFile;
+            G4Exception("PileupOverlay::Record()", "MyCode0014", FatalException, msg);
+            return;
+        }
+        PileupLibrary::WriteHeader(it->second);
+    }
+    PileupLibrary::WriteEvent(it->second, event);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupOverlay::SetNewValueInt(const G4String& key, G4int value)
+{
+    if (key == "BunchesBefore") fBunchesBefore = value;
+    else if (key == "BunchesAfter") fBunchesAfter = value;
+    else return;
+    G4cout << "Set " << key << " value in PileupOverlay = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupOverlay::SetNewValueDouble(const G4String& key, G4double value)
+{
+    if (key == "Mu") fMu = value;
+    else if (key == "BunchSpacing") fBunchSpacing = value;
+    else if (key == "EdepWindow") fEdepWindow = value;
+    else return;
+    G4cout << "Set " << key << " value in PileupOverlay = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PileupOverlay::SetNewValueString(const G4String& key, const G4String& value)
+{
+    // "none" switches the library off
+    G4String file = value == "none" ? G4String() : value;
+    if (key == "Library") {
+        fLibraryFile = file;
+        fLibrary.reset();
+    }
+    else if (key == "WriteLibrary") {
+        if (!fOutputFile.empty()) {
+            G4AutoLock lock(&libraryMutex);
+            auto it = OutputFiles().find(fOutputFile);
+            if (it != OutputFiles().end()) it->second.flush();
+        }
+        fOutputFile = file;
+    }
+    else return;
+    G4cout << "Set " << key << " value in PileupOverlay = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
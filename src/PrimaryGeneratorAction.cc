@@ -1,20 +1,33 @@
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "CheckpointManager.hh"
+#include "EventFileReader.hh"
 
 #include "G4Box.hh"
 #include "G4LogicalVolume.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
+#include "G4IonTable.hh"
 #include "G4SystemOfUnits.hh"
 #include "globals.hh"
 
 #include "G4RunManager.hh"
+#include "G4Run.hh"
 #include "G4Event.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
 #include "G4GeneralParticleSource.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4GenericMessenger.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
 #include "Randomize.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 namespace ZDC
 {
 
@@ -26,6 +39,12 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
     //fParticleGun = new G4ParticleGun(nofParticles);
     fParticleGun  = new G4GeneralParticleSource();
 
+    // beam mode
+    fBeamGun = new G4ParticleGun(1);
+    fBeamGun->SetParticleDefinition(G4ParticleTable::GetParticleTable()->FindParticle("neutron"));
+
+    fMessenger = new PrimaryGeneratorMessenger(this);
+
     // default particle kinematic
     //
     /*  auto particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("e-");
@@ -39,6 +58,8 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+  delete fMessenger;
+  delete fBeamGun;
   delete fParticleGun;
 }
 
@@ -75,7 +96,207 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
   // Set gun position
   fParticleGun->SetParticlePosition(G4ThreeVector(0., 0., -worldZHalfLength));
 */
-    fParticleGun->GeneratePrimaryVertex(event);
+    if (fMode == "beam") GenerateBeam(event);
+    else if (fMode == "file") GenerateFromFile(event);
+    else fParticleGun->GeneratePrimaryVertex(event);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateBeam(G4Event* event)
+{
+    G4ThreeVector direction = fBeamDirection.unit();
+    G4ThreeVector position = fOrigin;
+    if (fBeamSigma > 0.) {
+        // transverse to the beam direction
+        G4ThreeVector offset(G4RandGauss::shoot(0., fBeamSigma), G4RandGauss::shoot(0., fBeamSigma), 0.);
+        position += offset.rotateUz(direction);
+    }
+    if (fBeamDivergence > 0.) {
+        G4ThreeVector tilted(G4RandGauss::shoot(0., fBeamDivergence), G4RandGauss::shoot(0., fBeamDivergence), 1.);
+        direction = tilted.unit().rotateUz(direction);
+    }
+    // event IDs restart in every part of a checkpointed run
+    auto checkpoint = CheckpointManager::Instance();
+    G4double energy = BeamEnergy(event->GetEventID() + (checkpoint ? checkpoint->GetEventOffset() : 0));
+    if (fBeamEnergySpread > 0.) energy = std::max(0., energy * G4RandGauss::shoot(1., fBeamEnergySpread));
+
+    fBeamGun->SetParticlePosition(position);
+    fBeamGun->SetParticleMomentumDirection(direction);
+    fBeamGun->SetParticleEnergy(energy);
+    fBeamGun->GeneratePrimaryVertex(event);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PrimaryGeneratorAction::BeamEnergy(G4long eventID) const
+{
+    if (!fBeamEnergyList.empty()) return fBeamEnergyList[eventID % fBeamEnergyList.size()];
+    if (fBeamSpectrum == "flat") return fBeamEnergyMin + (fBeamEnergyMax - fBeamEnergyMin) * G4UniformRand();
+    if (fBeamSpectrum == "log") return fBeamEnergyMin * std::pow(fBeamEnergyMax / fBeamEnergyMin, G4UniformRand());
+    return fBeamEnergy;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateFromFile(G4Event* event)
+{
+    if (fFileName.empty()) {
+        G4Exception("PrimaryGeneratorAction::GenerateFromFile()", "MyCode0015", FatalException,
+                    "/gen/Mode file without /gen/File/Name.");
+        return;
+    }
+    if (!fReader) {
+        auto checkpoint = CheckpointManager::Instance();
+        fReader = EventFileReader::Open(fFileName, checkpoint ? checkpoint->GetResumedEvents() : 0);
+    }
+
+    GenEvent genEvent;
+    auto runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+    if (!fReader->Take(runID, event->GetEventID(), genEvent)) {
+        if (!fEndOfFile) {
+            G4ExceptionDescription msg;
+            msg << "End of event file " << fFileName << " at event " << event->GetEventID() << ", run aborted.";
+            G4Exception("PrimaryGeneratorAction::GenerateFromFile()", "MyCode0015", JustWarning, msg);
+            fEndOfFile = true;
+        }
+        G4RunManager::GetRunManager()->AbortRun(true);
+        return;
+    }
+
+    const G4ThreeVector axis = fBeamDirection.unit();
+    for (const auto& genVertex : genEvent.vertices) {
+        auto vertex = new G4PrimaryVertex(fOrigin + genVertex.position, genVertex.time);
+        for (const auto& genParticle : genVertex.particles) {
+            if (fMaxTheta > 0. && genParticle.momentum.angle(axis) > fMaxTheta) continue;
+            auto definition = FindParticle(genParticle.pdg);
+            if (!definition) continue;
+            vertex->SetPrimary(new G4PrimaryParticle(definition, genParticle.momentum.x(), genParticle.momentum.y(),
+                                                     genParticle.momentum.z()));
+        }
+        if (vertex->GetNumberOfParticle() > 0) event->AddPrimaryVertex(vertex);
+        else delete vertex;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ParticleDefinition* PrimaryGeneratorAction::FindParticle(G4int pdg)
+{
+    auto definition = G4ParticleTable::GetParticleTable()->FindParticle(pdg);
+    if (!definition && pdg > 1000000000) definition = G4IonTable::GetIonTable()->GetIon(pdg);
+    if (!definition) {
+        G4ExceptionDescription msg;
+        msg << "Unknown PDG code " << pdg << " in " << fFileName << ", particle skipped.";
+        G4Exception("PrimaryGeneratorAction::FindParticle()", "MyCode0015", JustWarning, msg);
+    }
+    return definition;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetNewValueDouble(G4String key, G4double value)
+{
+    if(key == "BeamEnergy"){
+        // a fixed energy replaces the list or spectrum
+        fBeamEnergy = value;
+        fBeamEnergyList.clear();
+        fBeamSpectrum = "";
+    }
+    else if(key == "BeamEnergySpread"){
+        fBeamEnergySpread = value;
+    }
+    else if(key == "BeamSigma"){
+        fBeamSigma = value;
+    }
+    else if(key == "BeamDivergence"){
+        fBeamDivergence = value;
+    }
+    else if(key == "MaxTheta"){
+        fMaxTheta = value;
+    }
+    else return;
+    G4cout << "Set " << key << " value in PrimaryGeneratorAction = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetNewValueString(G4String key, G4String value)
+{
+    if(key == "Mode"){
+        fMode = value;
+    }
+    else if(key == "BeamParticle"){
+        auto definition = G4ParticleTable::GetParticleTable()->FindParticle(value);
+        if (!definition) {
+            G4ExceptionDescription msg;
+            msg << "Unknown particle " << value << " for the beam.";
+            G4Exception("PrimaryGeneratorAction::SetNewValueString()", "MyCode0015", JustWarning, msg);
+            return;
+        }
+        fBeamGun->SetParticleDefinition(definition);
+    }
+    else if(key == "BeamEnergyList"){
+        // "e1 e2 ... unit"
+        std::istringstream is(value);
+        std::vector<G4String> tokens;
+        for (G4String token; is >> token;) tokens.push_back(token);
+        if (tokens.size() < 2 || !G4UnitDefinition::IsUnitDefined(tokens.back())) {
+            G4Exception("PrimaryGeneratorAction::SetNewValueString()", "MyCode0015", JustWarning,
+                        "/gen/Beam/EnergyList needs energies and a unit, e.g. 5 10 50 GeV.");
+            return;
+        }
+        G4double unit = G4UnitDefinition::GetValueOf(tokens.back());
+        fBeamEnergyList.clear();
+        for (std::size_t i = 0; i + 1 < tokens.size(); i++)
+            fBeamEnergyList.push_back(G4UIcommand::ConvertToDouble(tokens[i]) * unit);
+        fBeamSpectrum = "";
+    }
+    else if(key == "BeamEnergySpectrum"){
+        // "flat|log emin emax unit"
+        std::istringstream is(value);
+        G4String shape, unit;
+        G4double emin = 0., emax = 0.;
+        is >> shape >> emin >> emax >> unit;
+        emin *= G4UIcommand::ValueOf(unit);
+        emax *= G4UIcommand::ValueOf(unit);
+        if (shape != "flat" && shape != "log") {
+            G4Exception("PrimaryGeneratorAction::SetNewValueString()", "MyCode0015", JustWarning,
+                        "/gen/Beam/EnergySpectrum shape is flat or log.");
+            return;
+        }
+        if (emin <= 0. || emax <= emin) {
+            G4Exception("PrimaryGeneratorAction::SetNewValueString()", "MyCode0015", JustWarning,
+                        "/gen/Beam/EnergySpectrum needs 0 < emin < emax.");
+            return;
+        }
+        fBeamSpectrum = shape;
+        fBeamEnergyMin = emin;
+        fBeamEnergyMax = emax;
+        fBeamEnergyList.clear();
+    }
+    else if(key == "FileName"){
+        fFileName = value;
+        fReader.reset();
+        fEndOfFile = false;
+    }
+    else return;
+    G4cout << "Set " << key << " value in PrimaryGeneratorAction = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetNewValueVector(G4String key, G4ThreeVector value)
+{
+    if(key == "Origin"){
+        fOrigin = value;
+    }
+    else if(key == "BeamDirection"){
+        if (value.mag2() == 0.) return;
+        fBeamDirection = value.unit();
+    }
+    else return;
+    G4cout << "Set " << key << " value in PrimaryGeneratorAction = " << value << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
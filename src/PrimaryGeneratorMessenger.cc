@@ -0,0 +1,190 @@
+#include "PrimaryGeneratorMessenger.hh"
+
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWith3Vector.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* gen) : fPrimaryGenerator(gen)
+{
+  fGenDirectory = new G4UIdirectory("/gen/");
+  fGenDirectory->SetGuidance("Primary generator control");
+
+  fMode = new G4UIcmdWithAString("/gen/Mode", this);
+  fMode->SetGuidance("gps: G4GeneralParticleSource and the /gps/ commands (default),");
+  fMode->SetGuidance("beam: built-in pencil/gaussian beam (/gen/Beam/), file: generator events (/gen/File/).");
+  fMode->SetParameterName("mode", false);
+  fMode->SetCandidates("gps beam file");
+  fMode->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fOrigin = new G4UIcmdWith3VectorAndUnit("/gen/Origin", this);
+  fOrigin->SetGuidance("Beam spot of the beam mode, shift of the generator vertices of the file mode.");
+  fOrigin->SetParameterName("x", "y", "z", false);
+  fOrigin->SetDefaultUnit("cm");
+  fOrigin->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // beam mode
+  fBeamDirectory = new G4UIdirectory("/gen/Beam/");
+  fBeamDirectory->SetGuidance("Built-in beam, one particle per event");
+
+  fBeamParticle = new G4UIcmdWithAString("/gen/Beam/Particle", this);
+  fBeamParticle->SetGuidance("Beam particle (default neutron).");
+  fBeamParticle->SetParameterName("particle", false);
+  fBeamParticle->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamEnergy = new G4UIcmdWithADoubleAndUnit("/gen/Beam/Energy", this);
+  fBeamEnergy->SetGuidance("Kinetic energy of the beam particle (default 10 GeV).");
+  fBeamEnergy->SetParameterName("energy", false);
+  fBeamEnergy->SetRange("energy > 0");
+  fBeamEnergy->SetDefaultUnit("GeV");
+  fBeamEnergy->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamEnergyList = new G4UIcmdWithAString("/gen/Beam/EnergyList", this);
+  fBeamEnergyList->SetGuidance("Energies and unit, e.g. 5 10 20 50 100 GeV; event i gets energy i modulo their number.");
+  fBeamEnergyList->SetGuidance("/gen/Beam/Energy switches back to a fixed energy.");
+  fBeamEnergyList->SetParameterName("energies", false);
+  fBeamEnergyList->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamEnergySpectrum = new G4UIcommand("/gen/Beam/EnergySpectrum", this);
+  fBeamEnergySpectrum->SetGuidance("Energy drawn per event, flat in E or in log E between emin and emax.");
+  fBeamEnergySpectrum->SetGuidance("/gen/Beam/Energy switches back to a fixed energy.");
+  auto shape = new G4UIparameter("shape", 's', false);
+  shape->SetParameterCandidates("flat log");
+  fBeamEnergySpectrum->SetParameter(shape);
+  fBeamEnergySpectrum->SetParameter(new G4UIparameter("emin", 'd', false));
+  fBeamEnergySpectrum->SetParameter(new G4UIparameter("emax", 'd', false));
+  auto unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue("GeV");
+  fBeamEnergySpectrum->SetParameter(unit);
+  fBeamEnergySpectrum->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamEnergySpread = new G4UIcmdWithADouble("/gen/Beam/EnergySpread", this);
+  fBeamEnergySpread->SetGuidance("Relative gaussian energy spread (default 0).");
+  fBeamEnergySpread->SetParameterName("spread", false);
+  fBeamEnergySpread->SetRange("spread >= 0");
+  fBeamEnergySpread->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamDirection = new G4UIcmdWith3Vector("/gen/Beam/Direction", this);
+  fBeamDirection->SetGuidance("Beam direction (default 0 0 1), also the axis of /gen/File/MaxTheta.");
+  fBeamDirection->SetParameterName("dx", "dy", "dz", false);
+  fBeamDirection->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamSigma = new G4UIcmdWithADoubleAndUnit("/gen/Beam/Sigma", this);
+  fBeamSigma->SetGuidance("Gaussian transverse beam size per plane, 0 for a pencil beam (default).");
+  fBeamSigma->SetParameterName("sigma", false);
+  fBeamSigma->SetRange("sigma >= 0");
+  fBeamSigma->SetDefaultUnit("mm");
+  fBeamSigma->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBeamDivergence = new G4UIcmdWithADoubleAndUnit("/gen/Beam/Divergence", this);
+  fBeamDivergence->SetGuidance("Gaussian angular divergence per plane (default 0).");
+  fBeamDivergence->SetParameterName("divergence", false);
+  fBeamDivergence->SetRange("divergence >= 0");
+  fBeamDivergence->SetDefaultUnit("mrad");
+  fBeamDivergence->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // file mode
+  fFileDirectory = new G4UIdirectory("/gen/File/");
+  fFileDirectory->SetGuidance("Generator events from a file");
+
+  fFileName = new G4UIcmdWithAString("/gen/File/Name", this);
+  fFileName->SetGuidance("HepMC3 ASCII or binary event file (zdc_convert_events), read ahead in a thread.");
+  fFileName->SetParameterName("file", false);
+  fFileName->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMaxTheta = new G4UIcmdWithADoubleAndUnit("/gen/File/MaxTheta", this);
+  fMaxTheta->SetGuidance("Only particles within this angle of /gen/Beam/Direction are generated, 0 for all (default).");
+  fMaxTheta->SetParameterName("theta", false);
+  fMaxTheta->SetRange("theta >= 0");
+  fMaxTheta->SetDefaultUnit("mrad");
+  fMaxTheta->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete fMode;
+  delete fOrigin;
+  delete fBeamParticle;
+  delete fBeamEnergy;
+  delete fBeamEnergySpread;
+  delete fBeamEnergyList;
+  delete fBeamEnergySpectrum;
+  delete fBeamDirection;
+  delete fBeamSigma;
+  delete fBeamDivergence;
+  delete fFileName;
+  delete fMaxTheta;
+  delete fBeamDirectory;
+  delete fFileDirectory;
+  delete fGenDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fMode) {
+    fPrimaryGenerator->SetNewValueString("Mode", newValue);
+  }
+
+  if (command == fOrigin) {
+    fPrimaryGenerator->SetNewValueVector("Origin", fOrigin->GetNew3VectorValue(newValue));
+  }
+
+  if (command == fBeamParticle) {
+    fPrimaryGenerator->SetNewValueString("BeamParticle", newValue);
+  }
+
+  if (command == fBeamEnergy) {
+    fPrimaryGenerator->SetNewValueDouble("BeamEnergy", fBeamEnergy->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fBeamEnergySpread) {
+    fPrimaryGenerator->SetNewValueDouble("BeamEnergySpread", fBeamEnergySpread->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fBeamEnergyList) {
+    fPrimaryGenerator->SetNewValueString("BeamEnergyList", newValue);
+  }
+
+  if (command == fBeamEnergySpectrum) {
+    fPrimaryGenerator->SetNewValueString("BeamEnergySpectrum", newValue);
+  }
+
+  if (command == fBeamDirection) {
+    fPrimaryGenerator->SetNewValueVector("BeamDirection", fBeamDirection->GetNew3VectorValue(newValue));
+  }
+
+  if (command == fBeamSigma) {
+    fPrimaryGenerator->SetNewValueDouble("BeamSigma", fBeamSigma->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fBeamDivergence) {
+    fPrimaryGenerator->SetNewValueDouble("BeamDivergence", fBeamDivergence->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fFileName) {
+    fPrimaryGenerator->SetNewValueString("FileName", newValue);
+  }
+
+  if (command == fMaxTheta) {
+    fPrimaryGenerator->SetNewValueDouble("MaxTheta", fMaxTheta->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,20 @@
+#include "RegionInformation.hh"
+
+#include "G4SystemOfUnits.hh"
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RegionInformation::Print() const
+{
+    if (fTimeCut >= 0.) G4cout << "  time cut: " << fTimeCut / ns << " ns";
+    if (fEnergyCut >= 0.) G4cout << "  energy cut: " << fEnergyCut / MeV << " MeV";
+    if (fNeutronTimeCut >= 0.) G4cout << "  neutron time cut: " << fNeutronTimeCut / ns << " ns";
+    if (fNeutronEnergyCut >= 0.) G4cout << "  neutron energy cut: " << fNeutronEnergyCut / MeV << " MeV";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -1,7 +1,9 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "Constants.hh"
+#include "CheckpointManager.hh"
 
+#include "G4AccumulableManager.hh"
 #include "G4AnalysisManager.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
@@ -19,8 +21,8 @@ RunAction::RunAction(EventAction* eventAction)
  : G4UserRunAction(),
    fEventAction(eventAction)	
 {
-  // set printing event number per each event
-  G4RunManager::GetRunManager()->SetPrintProgress(1);
+  // print the event number every 1000 events, unless /run/printProgress is set
+  if (G4RunManager::GetRunManager()->GetPrintProgress() < 0) G4RunManager::GetRunManager()->SetPrintProgress(1000);
 
   // Create analysis manager
   // The choice of the output format is done via the specified
@@ -41,6 +43,8 @@ RunAction::RunAction(EventAction* eventAction)
   analysisManager->CreateNtupleDColumn("E.pi0");
   analysisManager->CreateNtupleDColumn("E.EscapeKin");
   analysisManager->CreateNtupleDColumn("E.EscapeKineAndNonBaryonMass");
+  // kinetic energy of the tracks killed by the region time/energy cuts (/det/Region/Set*Cut)
+  analysisManager->CreateNtupleDColumn("E.Cut");
   
   if (UsePbWO4EMCal) 
   analysisManager->CreateNtupleDColumn("Sec.EdepEMC");
@@ -56,6 +60,17 @@ RunAction::RunAction(EventAction* eventAction)
   analysisManager->CreateNtupleIColumn("Sec.NPESec3");
   analysisManager->CreateNtupleIColumn("Sec.NPESec2");
   analysisManager->CreateNtupleIColumn("Sec.NPESec1");
+  // background events overlaid on this one (/pileup/)
+  analysisManager->CreateNtupleIColumn("Pileup.N");
+  // true primary kinetic energy (sum over the primaries) and PDG code of the first one
+  analysisManager->CreateNtupleDColumn("Gen.E");
+  analysisManager->CreateNtupleIColumn("Gen.PDG");
+  // modules of sector 1, 2, 3, the size of the dense Mod.* arrays (AnaZDC.h reads them back)
+  for (G4int i = 1; i <= NSector; i++)
+  analysisManager->CreateNtupleIColumn("Mod.NSec" + std::to_string(i));
+  // layers of sector 1, 2, 3 in the Cell.* arrays (index module * nLayer + layer), 0 without /evt/CellEdep
+  for (G4int i = 1; i <= NSector; i++)
+  analysisManager->CreateNtupleIColumn("Cell.NLayerSec" + std::to_string(i));
 
   if (UsePbWO4EMCal) 
   analysisManager->CreateNtupleDColumn("Mod.EdepEmc",       fEventAction->GetEEmcModule());
@@ -71,9 +86,39 @@ RunAction::RunAction(EventAction* eventAction)
   analysisManager->CreateNtupleIColumn("Mod.NPESec3",       fEventAction->GetModNPE(2));
   analysisManager->CreateNtupleIColumn("Mod.NPESec2",       fEventAction->GetModNPE(1));
   analysisManager->CreateNtupleIColumn("Mod.NPESec1",       fEventAction->GetModNPE(0));
+
+  // zero-suppressed module arrays, only filled with /evt/SparseModules true
+  if (UsePbWO4EMCal) {
+  analysisManager->CreateNtupleIColumn("Mod.IdxEmc",        fEventAction->GetSpEmcIdx());
+  analysisManager->CreateNtupleDColumn("Mod.SpEdepEmc",     fEventAction->GetSpEEmcModule());
+  analysisManager->CreateNtupleIColumn("Mod.SpNPEEmc",      fEventAction->GetSpNPEEmcModule());
+  }
+  for (G4int i = NSector; i > 0; i--) {
+  analysisManager->CreateNtupleIColumn("Mod.IdxSec" + std::to_string(i),        fEventAction->GetSpModIdx(i-1));
+  analysisManager->CreateNtupleDColumn("Mod.SpEdepSecSen" + std::to_string(i),  fEventAction->GetSpModEdepSen(i-1));
+  analysisManager->CreateNtupleDColumn("Mod.SpEdepSecAbs" + std::to_string(i),  fEventAction->GetSpModEdepAbs(i-1));
+  analysisManager->CreateNtupleIColumn("Mod.SpNPESec" + std::to_string(i),      fEventAction->GetSpModNPE(i-1));
+  }
+  
+  // per-(module, layer) edep and first sensitive time (-1 without), only filled with /evt/CellEdep true
+  for (G4int i = NSector; i > 0; i--) {
+  analysisManager->CreateNtupleDColumn("Cell.EdepSecSen" + std::to_string(i),   fEventAction->GetCellEdepSen(i-1));
+  analysisManager->CreateNtupleDColumn("Cell.EdepSecAbs" + std::to_string(i),   fEventAction->GetCellEdepAbs(i-1));
+  analysisManager->CreateNtupleDColumn("Cell.TimeSec" + std::to_string(i),      fEventAction->GetCellTime(i-1));
+  }
   
+  // digitized SiPMs above threshold (/digi/Sipm/), raw photon hits only with /digi/Sipm/RawHits true
   analysisManager->CreateNtupleIColumn("Sipm.ID",           fEventAction->GetSipmID());
+  analysisManager->CreateNtupleIColumn("Sipm.NPE",          fEventAction->GetSipmNPE());
+  analysisManager->CreateNtupleDColumn("Sipm.Amp",          fEventAction->GetSipmAmp());
+  analysisManager->CreateNtupleDColumn("Sipm.Charge",       fEventAction->GetSipmCharge());
   analysisManager->CreateNtupleDColumn("Sipm.Time",         fEventAction->GetSipmTime());
+  analysisManager->CreateNtupleIColumn("Sipm.HitID",        fEventAction->GetSipmHitID());
+  analysisManager->CreateNtupleDColumn("Sipm.HitTime",      fEventAction->GetSipmHitTime());
+
+  // energy leaving through the leakage shell, index face*6 + class with faces front, back, side
+  // and classes gamma, e+-, mu+-, neutron, charged hadron, other (/det/UseLeakageShells)
+  analysisManager->CreateNtupleDColumn("Leak.E",            fEventAction->GetLeakE());
 
   analysisManager->CreateNtupleIColumn("Par.DetID",         fEventAction->GetDetectorID());
   analysisManager->CreateNtupleIColumn("Par.PDG",           fEventAction->GetParticlePDG());
@@ -93,6 +138,13 @@ RunAction::RunAction(EventAction* eventAction)
   analysisManager->CreateNtupleDColumn("Par.Outz",          fEventAction->GetParticleOutz());
   analysisManager->CreateNtupleDColumn("Par.Time",          fEventAction->GetParticleTime());  
   analysisManager->FinishNtuple();
+
+  // run sums of the sensitive edep
+  auto accumulableManager = G4AccumulableManager::Instance();
+  for (G4int i = 0; i <= NSector; i++) {
+    accumulableManager->Register(fEventAction->GetRunEdepSen(i));
+    accumulableManager->Register(fEventAction->GetRunEdepSen2(i));
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -102,12 +154,17 @@ void RunAction::BeginOfRunAction(const G4Run* /*run*/)
   // inform the runManager to save random number seed
   // G4RunManager::GetRunManager()->SetRandomNumberStore(true);
 
+  G4AccumulableManager::Instance()->Reset();
+  fTimer.Start();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Open an output file
   //
-  G4String fileName = "ZDC.root";
+  // one file per part of a checkpointed run (/ckpt/)
+  auto checkpoint = CheckpointManager::Instance();
+  G4String fileName = checkpoint ? checkpoint->GetOutputFileName() : G4String("ZDC.root");
 
   analysisManager->OpenFile(fileName);
   G4cout << "Using " << analysisManager->GetType() << G4endl;
@@ -115,10 +172,14 @@ void RunAction::BeginOfRunAction(const G4Run* /*run*/)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::EndOfRunAction(const G4Run* /*run*/)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
    G4cout<<"Process complete!"<<G4endl;
 
+  fTimer.Stop();
+  G4AccumulableManager::Instance()->Merge();
+  if (IsMaster()) PrintRunSummary(run);
+
   auto analysisManager = G4AnalysisManager::Instance();
   analysisManager->Write();
   analysisManager->CloseFile();
@@ -126,4 +187,32 @@ void RunAction::EndOfRunAction(const G4Run* /*run*/)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void RunAction::PrintRunSummary(const G4Run* run) const
+{
+  G4int nofEvents = run->GetNumberOfEvent();
+  if (nofEvents == 0) return;
+
+  // the user time of the process includes all worker threads
+  G4cout << "--------------------Run summary--------------------" << G4endl;
+  G4cout << " Events: " << nofEvents
+         << "  real time: " << fTimer.GetRealElapsed() << " s"
+         << "  CPU time: " << fTimer.GetUserElapsed() + fTimer.GetSystemElapsed() << " s"
+         << "  CPU time/event: " << (fTimer.GetUserElapsed() + fTimer.GetSystemElapsed()) / nofEvents * 1000. << " ms"
+         << G4endl;
+
+  auto printSpread = [&](G4int idx, const G4String& name) {
+    G4double mean = fEventAction->GetRunEdepSen(idx).GetValue() / nofEvents;
+    G4double rms2 = fEventAction->GetRunEdepSen2(idx).GetValue() / nofEvents - mean * mean;
+    G4double sigma = rms2 > 0. ? std::sqrt(rms2) : 0.;
+    G4cout << " " << name << " sensitive edep: mean " << G4BestUnit(mean, "Energy")
+           << "  sigma " << G4BestUnit(sigma, "Energy")
+           << "  sigma/mean " << (mean > 0. ? sigma / mean : 0.) << G4endl;
+  };
+  for (G4int i = NSector; i > 0; i--) printSpread(i - 1, "Sec" + std::to_string(i));
+  printSpread(NSector, "All ");
+  G4cout << "---------------------------------------------------" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 }  // namespace ZDC
@@ -0,0 +1,83 @@
+#include "SDFilter.hh"
+
+#include "G4OpticalPhoton.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SDFilter::SDFilter(const G4String& name)
+  : G4VSDFilter(name),
+    fTimeMin(-std::numeric_limits<G4double>::max()),
+    fTimeMax(std::numeric_limits<G4double>::max())
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SDFilter::Accept(const G4Step* step) const
+{
+    // the optical photons deposit nothing, the SiPM hits are kept
+    if (fEnergyFloor > 0. && step->GetTotalEnergyDeposit() < fEnergyFloor
+        && step->GetTrack()->GetDefinition() != G4OpticalPhoton::Definition())
+        return false;
+    if (!AcceptTime(step->GetPreStepPoint()->GetGlobalTime())) return false;
+    if (fParticles.empty()) return true;
+    return std::find(fParticles.begin(), fParticles.end(), step->GetTrack()->GetParticleDefinition())
+           != fParticles.end();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SDFilter::SetTimeWindow(G4double tmin, G4double tmax)
+{
+    // an empty window (tmax <= tmin) opens it again
+    if (tmax <= tmin) {
+        tmin = -std::numeric_limits<G4double>::max();
+        tmax = std::numeric_limits<G4double>::max();
+    }
+    fTimeMin = tmin;
+    fTimeMax = tmax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SDFilter::AddParticle(const G4String& particleName)
+{
+    if (particleName == "all") {
+        fParticles.clear();
+        return true;
+    }
+    auto particle = G4ParticleTable::GetParticleTable()->FindParticle(particleName);
+    if (!particle) return false;
+    if (std::find(fParticles.begin(), fParticles.end(), particle) == fParticles.end()) fParticles.push_back(particle);
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SDFilter::Print() const
+{
+    G4cout << std::setw(16) << GetName();
+    if (fTimeMin > -std::numeric_limits<G4double>::max() || fTimeMax < std::numeric_limits<G4double>::max())
+        G4cout << "  time window: " << fTimeMin / ns << " - " << fTimeMax / ns << " ns";
+    if (fEnergyFloor > 0.) G4cout << "  edep floor: " << fEnergyFloor / keV << " keV";
+    if (!fParticles.empty()) {
+        G4cout << "  particles:";
+        for (auto particle : fParticles) G4cout << " " << particle->GetParticleName();
+    }
+    G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -13,7 +13,7 @@
 namespace ZDC
 {
 
-G4ThreadLocal G4Allocator<SipmHit>* SipmHitAllocator = nullptr;
+G4ThreadLocal HitArena<SipmHit>* SipmHitArena = nullptr;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
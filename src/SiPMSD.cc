@@ -5,10 +5,12 @@
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
 #include "G4SDManager.hh"
+#include "G4OpticalPhoton.hh"
 #include "G4ios.hh"
 
 #include "EventAction.hh"
 #include "DetectorConstruction.hh"
+#include "SDFilter.hh"
 #include "RunAction.hh"
 
 namespace ZDC
@@ -26,8 +28,9 @@ SipmSD::SipmSD(const G4String& name, const G4String& hitsCollectionName)
 
 void SipmSD::Initialize(G4HCofThisEvent* hce)
 {
-  // Create hits collection
+  // Create hits collection, sized like the previous event's
   fHitsCollection = new SipmHitsCollection(SensitiveDetectorName, collectionName[0]); //SensitiveDetectorName 是啥？没有定义也没有用到
+  fHitsCollection->GetVector()->reserve(fLastNofHits);
 
   // Add this collection in hce
   auto hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
@@ -40,23 +43,26 @@ void SipmSD::Initialize(G4HCofThisEvent* hce)
 G4bool SipmSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 {
     G4String currentPhysicalName = step->GetPreStepPoint()->GetPhysicalVolume()->GetName();
-	G4String particleName = step->GetTrack()->GetDefinition()->GetParticleName();
 
   //if(currentPhysicalName=="SipmPhysical") { //应该都是，需确认 PMT or Sipm
-	if(particleName == "opticalphoton") {
+	if(step->GetTrack()->GetDefinition() == G4OpticalPhoton::Definition()) {
         SipmHit *aHit = new SipmHit();
 
 		G4Track* track = step->GetTrack();
 		G4StepPoint* prePoint = step->GetPreStepPoint();
+        // photons absorbed on the SiPM surface come from G4OpBoundaryProcess::InvokeSD,
+        // with the step ending on the SiPM and starting in the fiber core
+        G4StepPoint* sipmPoint = prePoint->GetSensitiveDetector() == this ? prePoint : step->GetPostStepPoint();
+        currentPhysicalName = sipmPoint->GetPhysicalVolume()->GetName();
       // Sipm hit
         if(currentPhysicalName == "PMTPhysical_EM") { //EM
-            aHit->SetSipmID(prePoint->GetTouchable()->GetCopyNumber(1)); //Sipm -> Crystal
+            aHit->SetSipmID(sipmPoint->GetTouchable()->GetCopyNumber(1)); //Sipm -> Crystal
         }
         else { //Shahslik
-            aHit->SetSipmID(prePoint->GetTouchable()->GetCopyNumber(2) + prePoint->GetTouchable()->GetCopyNumber(1)); //Sipm -> 16 holes -> Shashlik
+            aHit->SetSipmID(sipmPoint->GetTouchable()->GetCopyNumber(2) + sipmPoint->GetTouchable()->GetCopyNumber(1)); //Sipm -> 16 holes -> Shashlik
         }
 		//time
-		aHit->SetHitTime(prePoint->GetGlobalTime());
+		aHit->SetHitTime(sipmPoint->GetGlobalTime());
 
 		//stop and kill photons
 		track->SetTrackStatus(fStopAndKill); //确认能不能对track操作
@@ -69,9 +75,23 @@ G4bool SipmSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void SipmSD::EndOfEvent(G4HCofThisEvent*)
+void SipmSD::AddPhotonHit(G4int sipmID, G4double time)
 {
+    // no step to filter, only the readout time window applies
+    auto filter = static_cast<const SDFilter*>(GetFilter());
+    if (filter && !filter->AcceptTime(time)) return;
+
+    auto aHit = new SipmHit();
+    aHit->SetSipmID(sipmID);
+    aHit->SetHitTime(time);
+    fHitsCollection->insert(aHit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void SipmSD::EndOfEvent(G4HCofThisEvent*)
+{
+    fLastNofHits = fHitsCollection->entries();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,173 @@
+#include "SipmDigitizer.hh"
+
+#include "G4Poisson.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// out += a * shape over one pulse length; fixed trip count and no aliasing,
+// vectorized by the compiler at -O3
+void MultiplyAdd(float* __restrict out, const float* __restrict shape, float a)
+{
+    for (G4int j = 0; j < SipmDigitizer::kNSamples; j++) out[j] += a * shape[j];
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SipmDigitizer::Digitize(std::vector<std::pair<G4int, G4double>>& photons, std::vector<SipmDigi>& digis)
+{
+    if (!fTemplatesValid) BuildTemplates();
+    digis.clear();
+
+    // dark counts over the gate and one pulse length before it
+    const G4double darkStart = fGateStart - kNSamples * fSampleWidth;
+    const G4double darkWindow = 2 * kNSamples * fSampleWidth;
+
+    std::sort(photons.begin(), photons.end());
+    for (auto first = photons.begin(); first != photons.end();) {
+        auto last = std::find_if(first, photons.end(), [&](const auto& photon) { return photon.first != first->first; });
+
+        SipmDigi digi;
+        digi.id = first->first;
+        fBuffer.fill(0.f);
+        for (auto photon = first; photon != last; ++photon) {
+            if (G4UniformRand() >= fPDE) continue;
+            digi.npe++;
+            AddAvalanche(photon->second);
+        }
+        for (G4long i = G4Poisson(fDarkRate * darkWindow); i > 0; i--) {
+            AddAvalanche(darkStart + darkWindow * G4UniformRand());
+        }
+        if (Discriminate(digi)) digis.push_back(digi);
+
+        first = last;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// one fired cell, its crosstalk chain and their afterpulses
+void SipmDigitizer::AddAvalanche(G4double time)
+{
+    G4int nCells = 1;
+    while (G4UniformRand() < fCrosstalk) nCells++;
+
+    for (G4int i = 0; i < nCells; i++) {
+        AddPulse(time, G4RandGauss::shoot(1., fGainSpread));
+        if (G4UniformRand() < fAfterpulse) {
+            G4double delay = -fAfterpulseTime * std::log(G4UniformRand());
+            G4double recovered = fRecoveryTime > 0. ? 1. - std::exp(-delay / fRecoveryTime) : 1.;
+            AddPulse(time + delay, recovered * G4RandGauss::shoot(1., fGainSpread));
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SipmDigitizer::AddPulse(G4double time, G4double amplitude)
+{
+    // first sample of the template and the sub-sample phase
+    G4double x = (time - fGateStart) / fSampleWidth;
+    if (!(x > -kNSamples && x < kNSamples)) return;
+    G4int first = G4int(std::floor(x));
+    G4int phase = G4int(std::lround((x - first) * kNPhases));
+    if (phase == kNPhases) {
+        first++;
+        phase = 0;
+    }
+    if (first >= kNSamples) return;
+
+    MultiplyAdd(fBuffer.data() + kNSamples + first, fTemplates[phase].data(), float(amplitude));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SipmDigitizer::Discriminate(SipmDigi& digi) const
+{
+    const float* gate = fBuffer.data() + kNSamples;
+    const float threshold = float(fThreshold);
+
+    G4int crossing = -1;
+    for (G4int i = 0; i < kNSamples; i++) {
+        if (gate[i] >= threshold) {
+            crossing = i;
+            break;
+        }
+    }
+    if (crossing < 0) return false;
+
+    float peak = 0.f;
+    float sum = 0.f;
+    for (G4int i = 0; i < kNSamples; i++) {
+        peak = std::max(peak, gate[i]);
+        sum += gate[i];
+    }
+
+    // linear interpolation of the leading edge
+    G4double x = crossing;
+    if (crossing > 0) {
+        G4double below = gate[crossing - 1];
+        x = crossing - 1 + (threshold - below) / (gate[crossing] - below);
+    }
+    digi.time = fGateStart + x * fSampleWidth;
+    digi.amplitude = peak;
+    digi.charge = sum / fTemplateIntegral;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SipmDigitizer::BuildTemplates()
+{
+    const G4double fall = fFallTime;
+    const G4double rise = std::clamp(fRiseTime, 0., 0.999 * fFallTime);
+    auto shape = [&](G4double t) {
+        if (t < 0.) return 0.;
+        return rise > 0. ? std::exp(-t / fall) - std::exp(-t / rise) : std::exp(-t / fall);
+    };
+    const G4double peak = rise > 0. ? shape(rise * fall / (fall - rise) * std::log(fall / rise)) : 1.;
+
+    for (G4int p = 0; p < kNPhases; p++) {
+        for (G4int j = 0; j < kNSamples; j++) {
+            fTemplates[p][j] = float(shape((j - G4double(p) / kNPhases) * fSampleWidth) / peak);
+        }
+    }
+    fTemplateIntegral = (fall - rise) / peak / fSampleWidth;
+    fTemplatesValid = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SipmDigitizer::SetNewValueDouble(const G4String& key, G4double value)
+{
+    if (key == "PDE") fPDE = value;
+    else if (key == "Crosstalk") fCrosstalk = value;
+    else if (key == "Afterpulse") fAfterpulse = value;
+    else if (key == "AfterpulseTime") fAfterpulseTime = value;
+    else if (key == "RecoveryTime") fRecoveryTime = value;
+    else if (key == "DarkRate") fDarkRate = value;
+    else if (key == "GainSpread") fGainSpread = value;
+    else if (key == "Threshold") fThreshold = value;
+    else if (key == "GateStart") fGateStart = value;
+    else if (key == "SampleWidth") fSampleWidth = value;
+    else if (key == "RiseTime") fRiseTime = value;
+    else if (key == "FallTime") fFallTime = value;
+    else return;
+
+    // pulse shape on the sampling grid, rebuilt at the next event
+    if (key == "SampleWidth" || key == "RiseTime" || key == "FallTime") fTemplatesValid = false;
+    G4cout << "Set Sipm " << key << " value in SipmDigitizer = " << value << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
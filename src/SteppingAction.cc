@@ -0,0 +1,48 @@
+#include "SteppingAction.hh"
+#include "EventAction.hh"
+#include "RegionInformation.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4Neutron.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4Region.hh"
+#include "G4Step.hh"
+#include "G4VPhysicalVolume.hh"
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SteppingAction::SteppingAction(EventAction* eventAction)
+  : fEventAction(eventAction), fNeutron(G4Neutron::Definition()), fOpticalPhoton(G4OpticalPhoton::Definition())
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SteppingAction::UserSteppingAction(const G4Step* step)
+{
+    // regions without cuts have no information
+    auto region = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetRegion();
+    auto info = static_cast<const RegionInformation*>(region->GetUserInformation());
+    if (!info) return;
+
+    G4Track* track = step->GetTrack();
+    if (track->GetTrackStatus() != fAlive) return;
+
+    const G4ParticleDefinition* particle = track->GetParticleDefinition();
+    G4bool neutron = particle == fNeutron;
+    G4bool optical = particle == fOpticalPhoton;
+    G4double timeCut = info->GetTimeCut(neutron);
+    G4double energyCut = optical ? -1. : info->GetEnergyCut(neutron);
+
+    if ((timeCut >= 0. && track->GetGlobalTime() > timeCut) || (energyCut >= 0. && track->GetKineticEnergy() < energyCut)) {
+        track->SetTrackStatus(fStopAndKill);
+        if (!optical) fEventAction->AddEnergyCut(track->GetKineticEnergy());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -1,6 +1,8 @@
 #include "TrackingAction.hh"
 #include "EventAction.hh"
 
+#include "G4OpticalPhoton.hh"
+#include "G4PionZero.hh"
 #include "G4Track.hh"
 #include "G4TrackingManager.hh"
 
@@ -8,13 +10,18 @@ namespace ZDC
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-TrackingAction::TrackingAction(EventAction* eventAction) : G4UserTrackingAction(),fEventAction(eventAction)
+TrackingAction::TrackingAction(EventAction* eventAction) : G4UserTrackingAction(),fEventAction(eventAction),
+    fOpticalPhoton(G4OpticalPhoton::Definition()), fPi0(G4PionZero::Definition())
 {
 }
 
+// called for every track, optical photons (the bulk of them) return on a pointer comparison
 void TrackingAction::PreUserTrackingAction(const G4Track* aTrack)
 {
-    if(aTrack->GetDefinition()->GetParticleName()=="pi0"){
+    const G4ParticleDefinition* particle = aTrack->GetParticleDefinition();
+    if(particle == fOpticalPhoton) return;
+
+    if(particle == fPi0){
         double edep = aTrack->GetTotalEnergy();
         fEventAction->AddEdep_pi0(edep);
     }
@@ -27,6 +34,7 @@ void TrackingAction::PreUserTrackingAction(const G4Track* aTrack)
 void TrackingAction::PostUserTrackingAction(const G4Track* aTrack)
 {
     const G4ParticleDefinition* particle = aTrack->GetParticleDefinition();
+    if(particle == fOpticalPhoton) return;
 
     // 判断是否从世界边界逃逸
     const G4StepPoint* postStepPoint = aTrack->GetStep()->GetPostStepPoint();
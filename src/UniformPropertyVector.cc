@@ -0,0 +1,71 @@
+#include "UniformPropertyVector.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+UniformPropertyVector* UniformPropertyVector::Create(std::vector<G4double> energies,
+                                                     std::vector<G4double> values, G4double binWidth)
+{
+    Resample(energies, values, binWidth);
+    return new UniformPropertyVector(energies, values);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+UniformPropertyVector::UniformPropertyVector(const std::vector<G4double>& energies,
+                                             const std::vector<G4double>& values)
+  : G4MaterialPropertyVector(energies, values)
+{
+    if (numberOfNodes < 2 || edgeMax <= edgeMin) return;
+
+    G4double step = (edgeMax - edgeMin) / (numberOfNodes - 1);
+    for (std::size_t i = 1; i < numberOfNodes; i++) {
+        if (std::abs(binVector[i] - edgeMin - i * step) > 1.e-6 * step) return;
+    }
+
+    // G4PhysicsVector::GetBin() of a linear vector: (e - edgeMin) * invdBin
+    type = T_G4PhysicsLinearVector;
+    invdBin = 1. / step;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void UniformPropertyVector::Resample(std::vector<G4double>& energies, std::vector<G4double>& values,
+                                     G4double binWidth)
+{
+    std::size_t n = energies.size();
+    if (n < 2 || binWidth <= 0.) return;
+
+    G4double emin = energies.front();
+    G4double emax = energies.back();
+    G4double step = (emax - emin) / (n - 1);
+    G4bool uniform = true;
+    for (std::size_t i = 1; i < n && uniform; i++) {
+        uniform = std::abs(energies[i] - emin - i * step) < 1.e-6 * step;
+    }
+    if (uniform) return;
+
+    std::size_t nBins = std::max<std::size_t>(1, std::size_t(std::ceil((emax - emin) / binWidth - 1.e-9)));
+    step = (emax - emin) / nBins;
+
+    std::vector<G4double> newEnergies(nBins + 1), newValues(nBins + 1);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i <= nBins; i++) {
+        G4double e = (i == nBins) ? emax : emin + i * step;
+        while (j + 2 < n && energies[j + 1] < e) j++;
+        G4double f = (e - energies[j]) / (energies[j + 1] - energies[j]);
+        newEnergies[i] = e;
+        newValues[i] = values[j] + std::min(1., std::max(0., f)) * (values[j + 1] - values[j]);
+    }
+    energies.swap(newEnergies);
+    values.swap(newValues);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
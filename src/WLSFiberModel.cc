@@ -0,0 +1,209 @@
+#include "WLSFiberModel.hh"
+#include "SiPMSD.hh"
+#include "ZDCMaterials.hh"
+
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalParameters.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Poisson.hh"
+#include "G4SDManager.hh"
+#include "G4Tubs.hh"
+#include "G4VTouchable.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// round trips between the mirror and the SiPM before the photon is dropped
+constexpr G4int kMaxPasses = 10;
+
+// touchable depth of the outer cladding, the hole and the module seen from the core
+constexpr G4int kClad2Depth = 2;
+constexpr G4int kHoleDepth = 3;
+constexpr G4int kModuleDepth = 4;
+
+const G4MaterialPropertiesTable* CladdingTable(const G4Track* track)
+{
+    auto touchable = track->GetTouchable();
+    if (!touchable || touchable->GetHistoryDepth() < kModuleDepth) return nullptr;
+    return touchable->GetVolume(kClad2Depth)->GetLogicalVolume()->GetMaterial()->GetMaterialPropertiesTable();
+}
+
+G4double PropertyValue(const G4MaterialPropertiesTable* table, G4int index, G4double energy, G4double fallback)
+{
+    auto vector = table ? table->GetProperty(index) : nullptr;
+    return vector ? vector->Value(energy) : fallback;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WLSFiberModel::WLSFiberModel(const G4String& name, G4Region* envelope)
+  : G4VFastSimulationModel(name, envelope)
+{
+    // per thread, created after the SiPM sensitive detector
+    fSipmSD = dynamic_cast<SipmSD*>(G4SDManager::GetSDMpointer()->FindSensitiveDetector("SipmSD2", false));
+    if (!fSipmSD) {
+        G4Exception("WLSFiberModel::WLSFiberModel()", "MyCode0013", FatalException,
+                    "SiPM sensitive detector SipmSD2 not found.");
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool WLSFiberModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return &particle == G4OpticalPhoton::Definition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool WLSFiberModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    auto track = fastTrack.GetPrimaryTrack();
+    if (track->GetCurrentStepNumber() != 1) return false;
+
+    auto coreTable = track->GetMaterial()->GetMaterialPropertiesTable();
+    auto cladTable = CladdingTable(track);
+    if (!coreTable || !cladTable) return false;
+
+    G4double energy = track->GetTotalEnergy();
+    G4double nCore = PropertyValue(coreTable, kRINDEX, energy, 0.);
+    G4double nClad = PropertyValue(cladTable, kRINDEX, energy, DBL_MAX);
+    return nCore * std::abs(fastTrack.GetPrimaryTrackLocalDirection().z()) > nClad;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WLSFiberModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    auto track = fastTrack.GetPrimaryTrack();
+    auto coreTable = track->GetMaterial()->GetMaterialPropertiesTable();
+    auto materials = ZDCMaterials::GetInstance();
+    auto mirrorTable = materials->GetMirrorSurface()->GetMaterialPropertiesTable();
+    auto sipmTable = materials->GetSipmSurface()->GetMaterialPropertiesTable();
+
+    G4double energy = track->GetTotalEnergy();
+    G4double absLength = PropertyValue(coreTable, kABSLENGTH, energy, DBL_MAX);
+    G4double wlsLength = PropertyValue(coreTable, kWLSABSLENGTH, energy, DBL_MAX);
+    G4double groupVelocity =
+        PropertyValue(coreTable, kGROUPVEL, energy, c_light / PropertyValue(coreTable, kRINDEX, energy, 1.));
+    G4double mirrorReflectivity = PropertyValue(mirrorTable, kREFLECTIVITY, energy, 1.);
+    G4double sipmReflectivity = PropertyValue(sipmTable, kREFLECTIVITY, energy, 0.);
+    G4double sipmEfficiency = PropertyValue(sipmTable, kEFFICIENCY, energy, 0.);
+
+    G4double halfLength = static_cast<const G4Tubs*>(fastTrack.GetEnvelopeSolid())->GetZHalfLength();
+    G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+    G4double cosTheta = std::abs(fastTrack.GetPrimaryTrackLocalDirection().z());
+    G4double dirZ = fastTrack.GetPrimaryTrackLocalDirection().z() > 0. ? 1. : -1.;
+    G4double time = track->GetGlobalTime();
+    G4double pathLength = 0.;
+
+    for (G4int pass = 0; pass < 2 * kMaxPasses; pass++) {
+        G4double length = (halfLength - dirZ * position.z()) / cosTheta;
+        G4double absorbed = -absLength * std::log(G4UniformRand());
+        G4double shifted = -wlsLength * std::log(G4UniformRand());
+        G4double step = std::min({length, absorbed, shifted});
+
+        pathLength += step;
+        time += step / groupVelocity;
+        position.setZ(position.z() + dirZ * step * cosTheta);
+
+        if (step < length) {
+            // WLS absorption, the photons re-emitted here are tracked again
+            if (shifted < absorbed) EmitWLSPhotons(fastStep, coreTable, energy, position, time);
+            break;
+        }
+        if (dirZ > 0.) {
+            if (G4UniformRand() >= sipmReflectivity) {
+                if (G4UniformRand() < sipmEfficiency) {
+                    auto touchable = track->GetTouchable();
+                    fSipmSD->AddPhotonHit(touchable->GetCopyNumber(kHoleDepth) + touchable->GetCopyNumber(kModuleDepth),
+                                          time);
+                }
+                break;
+            }
+        }
+        else if (G4UniformRand() >= mirrorReflectivity) {
+            break;
+        }
+        dirZ = -dirZ;
+    }
+
+    fastStep.KillPrimaryTrack();
+    fastStep.ProposePrimaryTrackPathLength(pathLength);
+    fastStep.ProposePrimaryTrackFinalTime(time);
+    fastStep.ProposeTotalEnergyDeposited(0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// same sampling as G4OpWLS: number of photons, energy from WLSCOMPONENT below
+// the absorbed energy, isotropic direction and WLS time profile
+void WLSFiberModel::EmitWLSPhotons(G4FastStep& fastStep, const G4MaterialPropertiesTable* coreTable,
+                                   G4double energy, const G4ThreeVector& position, G4double time)
+{
+    auto component = coreTable->GetProperty(kWLSCOMPONENT);
+    if (!component) return;
+    G4double emin = component->GetMinEnergy();
+    G4double emax = std::min(component->GetMaxEnergy(), energy);
+    if (emax <= emin) return;
+
+    G4int nPhotons = 1;
+    if (coreTable->ConstPropertyExists(kWLSMEANNUMBERPHOTONS))
+        nPhotons = G4int(G4Poisson(coreTable->GetConstProperty(kWLSMEANNUMBERPHOTONS)));
+    if (nPhotons <= 0) return;
+
+    G4double timeConstant =
+        coreTable->ConstPropertyExists(kWLSTIMECONSTANT) ? coreTable->GetConstProperty(kWLSTIMECONSTANT) : 0.;
+    G4bool exponential = G4OpticalParameters::Instance()->GetWLSTimeProfile() == "exponential";
+    G4double maxValue = MaxValue(component);
+
+    fastStep.SetNumberOfSecondaryTracks(nPhotons);
+    for (G4int i = 0; i < nPhotons; i++) {
+        G4double sampledEnergy = 0.;
+        for (G4int tries = 0; tries < 1000 && sampledEnergy == 0.; tries++) {
+            G4double e = emin + (emax - emin) * G4UniformRand();
+            if (G4UniformRand() * maxValue < component->Value(e)) sampledEnergy = e;
+        }
+        if (sampledEnergy == 0.) continue;
+
+        G4double cost = 1. - 2. * G4UniformRand();
+        G4double sint = std::sqrt((1. - cost) * (1. + cost));
+        G4double phi = twopi * G4UniformRand();
+        G4ThreeVector direction(sint * std::cos(phi), sint * std::sin(phi), cost);
+        G4ThreeVector polarization = direction.orthogonal().unit();
+        polarization.rotate(twopi * G4UniformRand(), direction);
+
+        G4DynamicParticle photon(G4OpticalPhoton::Definition(), direction, sampledEnergy);
+        photon.SetPolarization(polarization);
+        G4double delay = exponential ? -timeConstant * std::log(G4UniformRand()) : timeConstant;
+        fastStep.CreateSecondaryTrack(photon, position, time + delay);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double WLSFiberModel::MaxValue(const G4MaterialPropertyVector* vector)
+{
+    auto it = fMaxValues.find(vector);
+    if (it != fMaxValues.end()) return it->second;
+    G4double maxValue = 0.;
+    for (std::size_t i = 0; i < vector->GetVectorLength(); i++) maxValue = std::max(maxValue, (*vector)[i]);
+    return fMaxValues[vector] = maxValue;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
@@ -0,0 +1,109 @@
+#include "WorkerInitialization.hh"
+#include "CalorHit.hh"
+#include "SiPMHit.hh"
+
+#include "G4Threading.hh"
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace ZDC
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// NUMA node of a CPU, its socket without node information
+G4int Domain(G4int cpu)
+{
+    const std::filesystem::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.compare(0, 4, "node") == 0 && name.size() > 4 && std::isdigit(name[4])) return std::stoi(name.substr(4));
+    }
+    G4int package = 0;
+    std::ifstream(dir / "topology/physical_package_id") >> package;
+    return package;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WorkerInitialization::WorkerInitialization(const G4String& mode) : fMode(mode)
+{
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+
+    std::map<G4int, std::vector<G4int>> domains;
+    for (G4int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) domains[Domain(cpu)].push_back(cpu);
+    }
+
+    if (fMode == "compact") {
+        for (const auto& [domain, cpus] : domains) {
+            for (auto cpu : cpus) {
+                fCpus.push_back(cpu);
+                fDomains.push_back(domain);
+            }
+        }
+    }
+    else {
+        // scatter
+        for (std::size_t i = 0; fCpus.size() < std::size_t(CPU_COUNT(&allowed)); i++) {
+            for (const auto& [domain, cpus] : domains) {
+                if (i >= cpus.size()) continue;
+                fCpus.push_back(cpus[i]);
+                fDomains.push_back(domain);
+            }
+        }
+    }
+    G4cout << "Pinning the workers " << fMode << " over " << fCpus.size() << " CPUs in " << domains.size()
+           << " NUMA node(s)" << G4endl;
+#else
+    G4Exception("WorkerInitialization::WorkerInitialization()", "MyCode0017", JustWarning,
+                "Thread pinning is only supported on Linux, the workers are not pinned.");
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WorkerInitialization::WorkerInitialize() const
+{
+    if (fCpus.empty()) return;
+
+#ifdef __linux__
+    const std::size_t i = G4Threading::G4GetThreadId() % fCpus.size();
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(fCpus[i], &cpus);
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        G4ExceptionDescription msg;
+        msg << "Cannot pin worker " << G4Threading::G4GetThreadId() << " to CPU " << fCpus[i] << ".";
+        G4Exception("WorkerInitialization::WorkerInitialize()", "MyCode0017", JustWarning, msg);
+        return;
+    }
+    G4cout << "Worker " << G4Threading::G4GetThreadId() << " pinned to CPU " << fCpus[i] << " (node " << fDomains[i]
+           << ")" << G4endl;
+#endif
+
+    // first touch of the hit memory on the pinned CPU
+    if (!CalorHitArena) CalorHitArena = new HitArena<CalorHit>;
+    if (!SipmHitArena) SipmHitArena = new HitArena<SipmHit>;
+    CalorHitArena->Reserve(1);
+    SipmHitArena->Reserve(1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace ZDC
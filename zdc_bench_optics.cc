@@ -0,0 +1,134 @@
+// zdc_bench_optics: per-lookup cost of the optical property vectors.
+//
+// Builds each property twice, once as a plain G4MaterialPropertyVector with
+// the points given in the data file (binary search for the bin) and once as
+// the UniformPropertyVector the materials use (resampled onto a uniform
+// grid, bin from an index computation), and times Value(e, idx) at random photon energies as
+// the optical processes call it. Also prints the largest difference between
+// the two, i.e. the resampling error, in Geant4 internal units.
+
+#include "OpticalDataReader.hh"
+#include "UniformPropertyVector.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+void PrintUsage()
+{
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " zdc_bench_optics [-d dataDir] [-w binWidth(eV)] [-n lookups]" << G4endl;
+    G4cerr << "   defaults: data/optics/v1, 0.005 eV, 10000000 lookups" << G4endl;
+}
+
+// ns per lookup, best of 3 passes
+G4double TimeLookups(const G4MaterialPropertyVector* vector, const std::vector<G4double>& energies,
+                     G4double& sum)
+{
+    G4double best = 0.;
+    for (G4int pass = 0; pass < 3; pass++) {
+        std::size_t idx = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (G4double e : energies) sum += vector->Value(e, idx);
+        G4double ns = std::chrono::duration<G4double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = pass ? std::min(best, ns) : ns;
+    }
+    return best / energies.size();
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+    G4String dataDir = "data/optics/v1";
+    G4double binWidth = 0.005 * eV;
+    G4int nLookups = 10000000;
+
+    for (G4int i = 1; i < argc; i += 2) {
+        G4String arg = argv[i];
+        if (i + 1 >= argc) {
+            PrintUsage();
+            return 2;
+        }
+        if (arg == "-d")
+            dataDir = argv[i + 1];
+        else if (arg == "-w")
+            binWidth = G4UIcommand::ConvertToDouble(argv[i + 1]) * eV;
+        else if (arg == "-n")
+            nLookups = std::max(1, G4UIcommand::ConvertToInt(argv[i + 1]));
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    ZDC::OpticalDataReader original(dataDir, 0.);
+    ZDC::OpticalDataReader uniform(dataDir, binWidth);
+
+    // the properties looked up on every optical photon step in the fiber,
+    // scintillator and crystals, and the SiPM efficiency
+    struct Entry
+    {
+        const char* file;
+        const char* property;
+    };
+    const Entry entries[] = {{"PMMA", "RINDEX"},          {"PMMA", "ABSLENGTH"},
+                             {"PMMA", "WLSABSLENGTH"},    {"Pethylene", "ABSLENGTH"},
+                             {"FPethylene", "ABSLENGTH"}, {"Polystyrene", "RINDEX"},
+                             {"Polystyrene", "ABSLENGTH"}, {"PbWO4", "RINDEX"},
+                             {"PbWO4", "ABSLENGTH"},      {"SipmSurface", "EFFICIENCY"}};
+
+    std::mt19937_64 engine(12345);
+    G4double sum = 0.;
+
+    std::printf("%-12s %-13s %9s %9s %12s %12s %8s %10s\n", "file", "property", "points", "points",
+                "ns/lookup", "ns/lookup", "speedup", "max diff");
+    std::printf("%-12s %-13s %9s %9s %12s %12s\n", "", "", "(file)", "(uniform)", "(file)", "(uniform)");
+    for (const auto& entry : entries) {
+        G4bool surface = G4String(entry.file).find("Surface") != std::string::npos;
+        auto table0 = surface ? original.ReadSurface(entry.file, "bench")->GetMaterialPropertiesTable()
+                              : original.ReadMaterial(entry.file);
+        auto table1 = surface ? uniform.ReadSurface(entry.file, "bench")->GetMaterialPropertiesTable()
+                              : uniform.ReadMaterial(entry.file);
+        auto points = table0->GetProperty(entry.property);
+        auto vector1 = dynamic_cast<ZDC::UniformPropertyVector*>(table1->GetProperty(entry.property));
+        if (!points || !vector1) continue;
+
+        // plain vector with the points of the file, as built by AddProperty()
+        std::vector<G4double> e0, v0;
+        for (std::size_t i = 0; i < points->GetVectorLength(); i++) {
+            e0.push_back(points->Energy(i));
+            v0.push_back((*points)[i]);
+        }
+        auto vector0 = new G4MaterialPropertyVector(e0, v0);
+
+        std::uniform_real_distribution<G4double> flat(vector0->GetMinEnergy(), vector0->GetMaxEnergy());
+        std::vector<G4double> energies(nLookups);
+        for (auto& e : energies) e = flat(engine);
+
+        G4double maxDiff = 0.;
+        for (std::size_t i = 0; i < std::min<std::size_t>(energies.size(), 100000); i++) {
+            maxDiff = std::max(maxDiff, std::abs(vector0->Value(energies[i]) - vector1->Value(energies[i])));
+        }
+        G4double t0 = TimeLookups(vector0, energies, sum);
+        G4double t1 = TimeLookups(vector1, energies, sum);
+        std::printf("%-12s %-13s %9zu %9zu %12.2f %12.2f %8.2f %10.3g\n", entry.file, entry.property,
+                    vector0->GetVectorLength(), vector1->GetVectorLength(), t0, t1, t0 / t1, maxDiff);
+        delete vector0;
+    }
+    std::printf("(checksum %g)\n", sum);
+    return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
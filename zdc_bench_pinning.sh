@@ -0,0 +1,73 @@
+#!/bin/bash
+# zdc_bench_pinning.sh: throughput of exampleZDC with the workers unpinned,
+# pinned compact and pinned scatter (exampleZDC --pin).
+#
+# Runs the same beam job once per mode and repeat, in the build directory
+# (the optical data and macros are read from there), and prints the best
+# event loop time (real time of the run summary, without the
+# initialization) and events/s of each mode and the gain over unpinned.
+# The NUMA layout is printed first (numactl or lscpu): on a single-node
+# machine all modes are expected to be equal within the noise. A NUMA
+# layout can be emulated on Linux with the numa=fake=<N> kernel boot
+# option, e.g. numa=fake=2 splits the CPUs and memory in two nodes.
+#
+#   ./zdc_bench_pinning.sh [-t nThreads] [-n nEvents] [-r repeats] [-e energy(GeV)]
+#   defaults: all CPUs, 200 events, 3 repeats, 10 GeV neutrons
+
+nThreads=$(nproc)
+nEvents=200
+repeats=3
+energy=10
+
+while getopts "t:n:r:e:" option; do
+    case ${option} in
+        t) nThreads=${OPTARG} ;;
+        n) nEvents=${OPTARG} ;;
+        r) repeats=${OPTARG} ;;
+        e) energy=${OPTARG} ;;
+        *) sed -n '14,15p' "$0"; exit 1 ;;
+    esac
+done
+
+if [ ! -x ./exampleZDC ]; then
+    echo "exampleZDC not found, run from the build directory"
+    exit 1
+fi
+
+if command -v numactl > /dev/null; then
+    numactl --hardware | grep -E "available|cpus"
+else
+    lscpu | grep -E "Socket|NUMA"
+fi
+
+macro=$(mktemp zdc_bench_pinning.XXXX.mac)
+log=$(mktemp zdc_bench_pinning.XXXX.log)
+trap 'rm -f ${macro} ${log}' EXIT
+cat > ${macro} << EOF
+/control/execute geometry.mac
+/run/initialize
+/gen/Mode beam
+/gen/Origin 1. 1. -200. cm
+/gen/Beam/Particle neutron
+/gen/Beam/Direction 0 0 1
+/gen/Beam/Energy ${energy} GeV
+/run/beamOn ${nEvents}
+EOF
+
+printf "%-8s %10s %10s %8s\n" pin "loop(s)" "events/s" gain
+reference=
+for mode in none compact scatter; do
+    best=
+    for ((i = 0; i < repeats; i++)); do
+        if ! ./exampleZDC -m ${macro} -t ${nThreads} --pin ${mode} > ${log} 2>&1; then
+            echo "exampleZDC --pin ${mode} failed, see the output:"
+            tail -20 ${log}
+            exit 1
+        fi
+        loopTime=$(grep "real time:" ${log} | tail -1 | sed 's/.*real time: *\([0-9.e+-]*\) s.*/\1/')
+        if [ -z "${best}" ] || [ $(echo "${loopTime} < ${best}" | bc) -eq 1 ]; then best=${loopTime}; fi
+    done
+    reference=${reference:-${best}}
+    printf "%-8s %10.2f %10.1f %7.3fx\n" ${mode} ${best} $(echo "${nEvents} / ${best}" | bc -l) \
+        $(echo "${reference} / ${best}" | bc -l)
+done
@@ -0,0 +1,282 @@
+// zdc_check_geometry: standalone overlap check of the ZDC geometry.
+//
+// Builds the geometry of DetectorConstruction (after an optional macro with
+// /det/ commands), then runs G4PVPlacement::CheckOverlaps for every placed
+// volume on a pool of threads.
+//
+// Each placement is keyed by a hash of its own solid and transformation and
+// of the content of its mother volume (mother solid, all sister placements)
+// together with the check resolution and tolerance. Results are cached in a
+// text file, so a repeated scan only re-checks the volumes whose module
+// (mother volume) changed.
+
+#include "DetectorConstruction.hh"
+#include "ZDCHash.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4RunManager.hh"
+#include "G4SolidStore.hh"
+#include "G4StateManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+#include "G4UImanager.hh"
+#include "G4VExceptionHandler.hh"
+#include "G4VSolid.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+void PrintUsage()
+{
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " zdc_check_geometry [-m macro] [-t nThreads] [-r resolution] [-e tolerance(mm)]" << G4endl;
+    G4cerr << "                    [-c cacheFile] [-n]" << G4endl;
+    G4cerr << "   -m: macro with /det/ commands applied before the geometry is built" << G4endl;
+    G4cerr << "   -r: number of surface points per volume (default 1000)" << G4endl;
+    G4cerr << "   -c: result cache (default zdc_overlaps.cache), -n: ignore the cache" << G4endl;
+}
+
+// G4Exception messages of the volume being checked by this thread
+thread_local std::string* currentLog = nullptr;
+
+class OverlapExceptionHandler : public G4VExceptionHandler
+{
+  public:
+    G4bool Notify(const char* origin, const char* code, G4ExceptionSeverity severity,
+                  const char* description) override
+    {
+        if (currentLog) {
+            *currentLog += G4String(code) + " from " + origin + ":\n" + description;
+        }
+        return severity == FatalException || severity == FatalErrorInArgument;
+    }
+};
+
+struct CheckResult
+{
+    G4PVPlacement* volume = nullptr;
+    std::uint64_t key = 0;
+    G4bool cached = false;
+    G4bool overlap = false;
+    std::string log;
+};
+
+class GeometryHasher
+{
+  public:
+    std::uint64_t Solid(const G4VSolid* solid)
+    {
+        auto it = fSolids.find(solid);
+        if (it != fSolids.end()) return it->second;
+        std::ostringstream os;
+        os.precision(17);
+        solid->StreamInfo(os);
+        ZDC::Fnv1a h;
+        h.Add(os.str());
+        return fSolids[solid] = h.Value();
+    }
+
+    std::uint64_t Placement(const G4VPhysicalVolume* pv)
+    {
+        ZDC::Fnv1a h;
+        h.Add(pv->GetName());
+        h.Add(pv->GetCopyNo());
+        h.Add(Solid(pv->GetLogicalVolume()->GetSolid()));
+        auto t = pv->GetTranslation();
+        h.Add(t.x());
+        h.Add(t.y());
+        h.Add(t.z());
+        if (auto rot = pv->GetRotation()) {
+            for (G4double v : {rot->xx(), rot->xy(), rot->xz(), rot->yx(), rot->yy(), rot->yz(),
+                               rot->zx(), rot->zy(), rot->zz()})
+                h.Add(v);
+        }
+        return h.Value();
+    }
+
+    // mother solid and all its daughter placements
+    std::uint64_t Mother(const G4LogicalVolume* mother)
+    {
+        auto it = fMothers.find(mother);
+        if (it != fMothers.end()) return it->second;
+        ZDC::Fnv1a h;
+        h.Add(Solid(mother->GetSolid()));
+        for (std::size_t i = 0; i < mother->GetNoDaughters(); i++)
+            h.Add(Placement(mother->GetDaughter(i)));
+        return fMothers[mother] = h.Value();
+    }
+
+  private:
+    std::unordered_map<const G4VSolid*, std::uint64_t> fSolids;
+    std::unordered_map<const G4LogicalVolume*, std::uint64_t> fMothers;
+};
+
+// cache file: one "key overlap name copyNo" line per volume
+std::unordered_map<std::uint64_t, G4bool> ReadCache(const G4String& fileName)
+{
+    std::unordered_map<std::uint64_t, G4bool> cache;
+    std::ifstream in(fileName);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        std::uint64_t key;
+        G4int overlap;
+        if (is >> std::hex >> key >> std::dec >> overlap) cache[key] = overlap != 0;
+    }
+    return cache;
+}
+
+void WriteCache(const G4String& fileName, const std::vector<CheckResult>& results)
+{
+    std::ofstream out(fileName);
+    out << "# zdc_check_geometry overlap cache: key overlap volume copyNo\n";
+    for (const auto& r : results) {
+        char key[17];
+        std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(r.key));
+        out << key << " " << r.overlap << " " << r.volume->GetName() << " " << r.volume->GetCopyNo() << "\n";
+    }
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+    G4String macro;
+    G4String cacheFile = "zdc_overlaps.cache";
+    G4bool useCache = true;
+    G4int nThreads = G4int(std::max(1u, std::thread::hardware_concurrency()));
+    G4int resolution = 1000;
+    G4double tolerance = 0.;
+
+    for (G4int i = 1; i < argc; i++) {
+        G4String arg = argv[i];
+        if (arg == "-n") {
+            useCache = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            PrintUsage();
+            return 2;
+        }
+        if (arg == "-m")
+            macro = argv[++i];
+        else if (arg == "-t")
+            nThreads = std::max(1, G4UIcommand::ConvertToInt(argv[++i]));
+        else if (arg == "-r")
+            resolution = G4UIcommand::ConvertToInt(argv[++i]);
+        else if (arg == "-e")
+            tolerance = G4UIcommand::ConvertToDouble(argv[++i]) * mm;
+        else if (arg == "-c")
+            cacheFile = argv[++i];
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    // the /det/ commands need a run manager, which is never initialized here
+    auto runManager = new G4RunManager;
+    auto detConstruction = new ZDC::DetectorConstruction();
+    runManager->SetUserInitialization(detConstruction);
+
+    if (macro.size()) {
+        G4UImanager::GetUIpointer()->ApplyCommand("/control/execute " + macro);
+    }
+    detConstruction->Construct();
+
+    // Boolean solids build their list of primitives on the first
+    // GetPointOnSurface() call, do it here before the threads share them
+    for (auto solid : *G4SolidStore::GetInstance()) {
+        solid->GetPointOnSurface();
+    }
+
+    // Work list and cache keys
+    GeometryHasher hasher;
+    std::vector<CheckResult> results;
+    for (auto pv : *G4PhysicalVolumeStore::GetInstance()) {
+        auto placement = dynamic_cast<G4PVPlacement*>(pv);
+        if (!placement || !placement->GetMotherLogical()) continue;
+        ZDC::Fnv1a h;
+        h.Add(hasher.Placement(placement));
+        h.Add(hasher.Mother(placement->GetMotherLogical()));
+        h.Add(resolution);
+        h.Add(tolerance);
+        CheckResult result;
+        result.volume = placement;
+        result.key = h.Value();
+        results.push_back(result);
+    }
+
+    std::vector<CheckResult*> toCheck;
+    auto cache = useCache ? ReadCache(cacheFile) : std::unordered_map<std::uint64_t, G4bool>();
+    for (auto& r : results) {
+        auto it = cache.find(r.key);
+        if (it != cache.end()) {
+            r.cached = true;
+            r.overlap = it->second;
+        }
+        else {
+            toCheck.push_back(&r);
+        }
+    }
+
+    G4cout << "zdc_check_geometry: " << results.size() << " placements, " << results.size() - toCheck.size()
+           << " from cache, checking " << toCheck.size() << " on " << nThreads << " threads" << G4endl;
+
+    // Thread pool, each thread takes the next unchecked volume
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        OverlapExceptionHandler handler;
+        std::size_t i;
+        while ((i = next++) < toCheck.size()) {
+            auto r = toCheck[i];
+            currentLog = &r->log;
+            r->overlap = r->volume->CheckOverlaps(resolution, tolerance, false, 1);
+            currentLog = nullptr;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (G4int i = 0; i < nThreads; i++) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    G4double seconds = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+
+    if (useCache) WriteCache(cacheFile, results);
+
+    // Report, one line per overlapping volume name and copy number
+    std::map<std::string, const CheckResult*> overlaps;
+    for (const auto& r : results) {
+        if (r.overlap)
+            overlaps.emplace(r.volume->GetName() + ":" + std::to_string(r.volume->GetCopyNo()), &r);
+    }
+    for (const auto& [name, r] : overlaps) {
+        G4cout << "Overlap in " << name << " (mother " << r->volume->GetMotherLogical()->GetName() << ")"
+               << (r->cached ? " [cached]" : "") << G4endl;
+        if (!r->log.empty()) G4cout << r->log << G4endl;
+    }
+    G4cout << "zdc_check_geometry: checked " << toCheck.size() << " placements in " << seconds << " s, "
+           << overlaps.size() << " with overlaps" << G4endl;
+
+    delete runManager;
+    return overlaps.empty() ? 0 : 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
@@ -0,0 +1,41 @@
+// zdc_convert_events: HepMC3 ASCII generator events to the binary event
+// format of /gen/File/Name (EventFileReader).
+//
+// Keeps the final-state particles with their production vertices, in the
+// units of the binary format (mm, ns, MeV); the binary file is read without
+// any text parsing, e.g. for large spectator-neutron samples.
+
+#include "EventFileReader.hh"
+
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        G4cerr << " Usage: " << G4endl;
+        G4cerr << " zdc_convert_events input.hepmc output.bin" << G4endl;
+        return 2;
+    }
+
+    ZDC::EventFileReader reader(argv[1], false);
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out) {
+        G4cerr << "Cannot write " << argv[2] << G4endl;
+        return 1;
+    }
+    ZDC::EventFileReader::WriteBinaryHeader(out);
+
+    ZDC::GenEvent event;
+    long nEvents = 0, nParticles = 0;
+    while (reader.Read(event)) {
+        ZDC::EventFileReader::WriteBinary(out, event);
+        nEvents++;
+        for (const auto& vertex : event.vertices) nParticles += vertex.particles.size();
+    }
+    G4cout << nEvents << " events, " << nParticles << " final-state particles written to " << argv[2] << G4endl;
+    return out ? 0 : 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,311 @@
+// zdc_submit: runs a macro as K exampleZDC processes (shards) on the local
+// machine and merges or indexes their output.
+//
+// The events are split evenly over the shards. Shard k gets a copy of the
+// macro with the count of its /run/beamOn (or /ckpt/BeamOn) replaced by its
+// share, the seed number firstSeed + k (exampleZDC --seed, hashed into the
+// engine seeds, distinct for any number of shards unlike the clock), its first
+// event number (--first-event, so the EventIDs, the beam energy list and the
+// event file continue over the shards) and the output <dir>/ZDC_<k>.root.
+// Output files of an earlier run in <dir> (ZDC_<k>.root, ZDC_<k>_<part>.root)
+// are removed first, so only the files written by this run are indexed.
+// At most P shards run at a time, each with T threads; their output goes to
+// <dir>/shard_<k>.log. At the end <dir>/ZDC_shards.txt indexes the shards
+// (seed, events, exit status, files), e.g. for TChain::Add, and --merge adds
+// the files into <dir>/ZDC.root with ROOT's hadd.
+//
+// Run from the build directory, the macros read geometry.mac and the
+// optical data from the current directory.
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+struct Shard
+{
+    long seed = 0;
+    long firstEvent = 0;
+    long nEvents = 0;
+    std::string macro;
+    std::string output;  // base name, exampleZDC -o
+    std::string log;
+    int status = -1;
+    double seconds = 0.;
+    std::chrono::steady_clock::time_point start;
+};
+
+void PrintUsage()
+{
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " zdc_submit -m macro -n nEvents -j nJobs [-t threadsPerJob] [-P parallelJobs] [-s firstSeed]"
+              " [-o outputDir] [-x exampleZDC] [--merge]"
+           << G4endl;
+    G4cerr << "   defaults: 1 thread, all jobs in parallel, seed 0, shards/, ./exampleZDC" << G4endl;
+    G4cerr << "   the macro needs exactly one /run/beamOn or /ckpt/BeamOn line, its count is replaced" << G4endl;
+}
+
+// copy of the macro with the beamOn count replaced, false without exactly one
+bool WriteShardMacro(const std::string& macro, const Shard& shard)
+{
+    std::ifstream in(macro);
+    std::ostringstream out;
+    int nBeamOn = 0;
+    for (std::string line; std::getline(in, line);) {
+        std::istringstream is(line);
+        std::string command;
+        is >> command;
+        if (command == "/run/beamOn" || command == "/ckpt/BeamOn") {
+            line = command + " " + std::to_string(shard.nEvents);
+            nBeamOn++;
+        }
+        out << line << "\n";
+    }
+    if (!in.eof() || nBeamOn != 1) return false;
+    std::ofstream(shard.macro) << out.str();
+    return true;
+}
+
+pid_t Start(const std::string& executable, const std::vector<std::string>& arguments, const std::string& log)
+{
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(executable.c_str()));
+    for (const auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+    execvp(argv[0], argv.data());
+    std::perror(executable.c_str());
+    _exit(127);
+}
+
+int Wait(pid_t pid)
+{
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+// ZDC_<k>.root, or ZDC_<k>_<part>.root of a checkpointed macro
+bool IsOutputFile(const std::string& file, const std::string& name)
+{
+    if (file == name + ".root") return true;
+    if (file.size() <= name.size() + 6 || file.compare(0, name.size() + 1, name + "_") != 0 ||
+        file.compare(file.size() - 5, 5, ".root") != 0)
+        return false;
+    const std::string part = file.substr(name.size() + 1, file.size() - name.size() - 6);
+    return std::all_of(part.begin(), part.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+}
+
+// output files of a shard written since start, sorted by part
+std::vector<std::string> OutputFiles(const std::string& directory, const std::string& output,
+                                     std::filesystem::file_time_type start)
+{
+    namespace fs = std::filesystem;
+    const std::string name = fs::path(output).filename().string();
+    std::vector<std::pair<long, std::string>> parts;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        const std::string file = entry.path().filename().string();
+        if (!IsOutputFile(file, name) || entry.last_write_time(error) < start) continue;
+        const long part = file == name + ".root" ? -1 : std::atol(file.c_str() + name.size() + 1);
+        parts.emplace_back(part, entry.path().string());
+    }
+    std::sort(parts.begin(), parts.end());
+    std::vector<std::string> files;
+    for (const auto& part : parts) files.push_back(part.second);
+    return files;
+}
+
+// output files of an earlier run in the same directory, they would be
+// indexed and merged with the new ones
+long RemoveOutputFiles(const std::string& directory, const std::string& output)
+{
+    namespace fs = std::filesystem;
+    const std::string name = fs::path(output).filename().string();
+    long nRemoved = 0;
+    std::error_code error;
+    std::vector<fs::path> stale;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (IsOutputFile(entry.path().filename().string(), name)) stale.push_back(entry.path());
+    }
+    for (const auto& file : stale) {
+        if (fs::remove(file, error)) nRemoved++;
+    }
+    return nRemoved;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+    std::string macro;
+    std::string directory = "shards";
+    std::string executable = "./exampleZDC";
+    long nEvents = 0, nJobs = 0, nThreads = 1, nParallel = 0, firstSeed = 0;
+    bool merge = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string option = argv[i];
+        if (option == "--merge") {
+            merge = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            PrintUsage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (option == "-m") macro = value;
+        else if (option == "-n") nEvents = std::atol(value);
+        else if (option == "-j") nJobs = std::atol(value);
+        else if (option == "-t") nThreads = std::atol(value);
+        else if (option == "-P") nParallel = std::atol(value);
+        else if (option == "-s") firstSeed = std::atol(value);
+        else if (option == "-o") directory = value;
+        else if (option == "-x") executable = value;
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (macro.empty() || nEvents <= 0 || nJobs <= 0 || nJobs > nEvents || nThreads <= 0) {
+        PrintUsage();
+        return 2;
+    }
+    if (firstSeed < 0) {
+        PrintUsage();
+        return 2;
+    }
+    if (nParallel <= 0) nParallel = nJobs;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        G4cerr << "Cannot create " << directory << ": " << error.message() << G4endl;
+        return 1;
+    }
+
+    // split and write the shard macros
+    std::vector<Shard> shards(nJobs);
+    long firstEvent = 0;
+    for (long k = 0; k < nJobs; k++) {
+        auto& shard = shards[k];
+        shard.seed = firstSeed + k;
+        shard.firstEvent = firstEvent;
+        shard.nEvents = nEvents / nJobs + (k < nEvents % nJobs ? 1 : 0);
+        shard.macro = directory + "/shard_" + std::to_string(k) + ".mac";
+        shard.output = directory + "/ZDC_" + std::to_string(k);
+        shard.log = directory + "/shard_" + std::to_string(k) + ".log";
+        firstEvent += shard.nEvents;
+        if (!WriteShardMacro(macro, shard)) {
+            G4cerr << "Cannot read " << macro << " or it has not exactly one /run/beamOn or /ckpt/BeamOn" << G4endl;
+            return 1;
+        }
+    }
+
+    // earlier outputs of the shards, also of a checkpointed run with more parts
+    long nStale = 0;
+    for (const auto& shard : shards) nStale += RemoveOutputFiles(directory, shard.output);
+    if (nStale > 0) G4cout << "Removed " << nStale << " output files of an earlier run in " << directory << G4endl;
+    // files older than this are not from these shards (coarse file system clocks)
+    const auto submitTime = std::filesystem::file_time_type::clock::now() - std::chrono::seconds(2);
+
+    // job queue
+    std::deque<long> pending;
+    for (long k = 0; k < nJobs; k++) pending.push_back(k);
+    std::map<pid_t, long> running;
+    long nFailed = 0, nDone = 0;
+    while (!pending.empty() || !running.empty()) {
+        while (!pending.empty() && long(running.size()) < nParallel) {
+            auto& shard = shards[pending.front()];
+            pid_t pid = Start(executable,
+                              {"-m", shard.macro, "-t", std::to_string(nThreads), "--seed", std::to_string(shard.seed),
+                               "--first-event", std::to_string(shard.firstEvent), "-o", shard.output},
+                              shard.log);
+            if (pid < 0) {
+                G4cerr << "Cannot start shard " << pending.front() << ": " << std::strerror(errno) << G4endl;
+                return 1;
+            }
+            shard.start = std::chrono::steady_clock::now();
+            running[pid] = pending.front();
+            pending.pop_front();
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        auto it = running.find(pid);
+        if (it == running.end()) continue;
+        auto& shard = shards[it->second];
+        shard.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        shard.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - shard.start).count();
+        if (shard.status != 0) nFailed++;
+        nDone++;
+        G4cout << "shard " << it->second << " (" << shard.nEvents << " events) "
+               << (shard.status == 0 ? "done" : "FAILED, see " + shard.log) << " in " << shard.seconds << " s, "
+               << nDone << "/" << nJobs << G4endl;
+        running.erase(it);
+    }
+
+    // index and merge
+    std::vector<std::string> files;
+    std::ofstream index(directory + "/ZDC_shards.txt");
+    index << "# shard seed firstEvent nEvents status seconds files\n";
+    for (long k = 0; k < nJobs; k++) {
+        const auto& shard = shards[k];
+        index << k << " " << shard.seed << " " << shard.firstEvent << " " << shard.nEvents << " " << shard.status
+              << " " << shard.seconds;
+        if (shard.status == 0) {
+            for (const auto& file : OutputFiles(directory, shard.output, submitTime)) {
+                index << " " << file;
+                files.push_back(file);
+            }
+        }
+        index << "\n";
+    }
+    G4cout << files.size() << " output files indexed in " << directory << "/ZDC_shards.txt" << G4endl;
+
+    if (merge && !files.empty()) {
+        std::vector<std::string> arguments = {"-f", directory + "/ZDC.root"};
+        arguments.insert(arguments.end(), files.begin(), files.end());
+        pid_t pid = Start("hadd", arguments, directory + "/hadd.log");
+        if (pid < 0 || Wait(pid) != 0) {
+            G4cerr << "hadd failed, see " << directory << "/hadd.log; the index is still valid" << G4endl;
+            return 1;
+        }
+        G4cout << "merged into " << directory << "/ZDC.root" << G4endl;
+    }
+
+    if (nFailed > 0) G4cerr << nFailed << " of " << nJobs << " shards failed" << G4endl;
+    return nFailed > 0 ? 1 : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......